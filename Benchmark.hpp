@@ -0,0 +1,258 @@
+#pragma once
+#include <chrono>         // steady_clock, duration
+#include <cstddef>        // size_t
+#include <filesystem>     // exists()
+#include <fstream>        // ifstream
+#include <iomanip>        // setw(), setprecision()
+#include <iostream>       // clog, fixed
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if __has_include( <fcntl.h> )
+  #include <fcntl.h>      // open(), posix_fadvise()
+  #include <unistd.h>     // close(), read(), sysconf()
+#endif
+
+#if __has_include( <malloc.h> ) && defined( __GLIBC__ )
+  #include <malloc.h>     // malloc_trim()
+#endif
+
+#if __has_include( <linux/perf_event.h> )
+  #include <linux/perf_event.h>   // perf_event_attr
+  #include <sys/ioctl.h>          // ioctl()
+  #include <sys/syscall.h>        // SYS_perf_event_open
+  #define BENCHMARK_HAS_PERF_EVENTS 1
+#endif
+
+namespace Benchmark
+{
+  // The grocery item database files, smallest to largest, that a benchmark runs against when they are present in the current
+  // working directory.  Missing files are skipped.
+  inline std::vector<std::string> database_files()
+  {
+    std::vector<std::string> files;
+    for( auto name : { "Grocery_UPC_Database-Small.dat", "Grocery_UPC_Database-Medium.dat", "Grocery_UPC_Database-Large.dat", "Grocery_UPC_Database-Full.dat" } )
+    {
+      if( std::filesystem::exists( name ) ) files.emplace_back( name );
+    }
+    return files;
+  }
+
+
+
+
+
+
+
+
+
+  // Ask the operating system to drop a file's cached pages so the next read of the file comes from the disk, approximating a cold
+  // start without needing privileges to flush the whole page cache.  Where that isn't supported, this does nothing and measurements
+  // are warm.
+  inline void evict_from_page_cache( std::string const & filename )
+  {
+    #if __has_include( <fcntl.h> ) && defined( POSIX_FADV_DONTNEED )
+      if( int fd = ::open( filename.c_str(), O_RDONLY ); fd >= 0 )
+      {
+        ::posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED );
+        ::close( fd );
+      }
+    #else
+      (void) filename;
+    #endif
+  }
+
+
+
+
+
+
+
+
+
+  // Keep the optimizer from discarding a computation whose result is otherwise unused
+  template<typename T>
+  inline void do_not_optimize( T const & value )
+  {
+    asm volatile( "" : : "r,m"( value ) : "memory" );
+  }
+
+
+
+
+
+
+
+
+
+  // Run work() repeatedly and return the fastest wall clock time, in seconds, of a single run.  The fastest run is the one least
+  // disturbed by the rest of the system.
+  template<typename Work>
+  double seconds( Work && work, std::size_t repetitions = 5 )
+  {
+    double best = 0.0;
+    for( std::size_t i = 0; i < repetitions; ++i )
+    {
+      auto start = std::chrono::steady_clock::now();
+      work();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      if( i == 0 || elapsed.count() < best ) best = elapsed.count();
+    }
+    return best;
+  }
+
+
+
+
+
+
+
+
+
+  // The process's resident set size in bytes, or 0 where /proc/self/statm isn't available.  Freed heap memory is first handed back to
+  // the operating system where the C library allows, so consecutive measurements don't inherit each other's free lists.
+  inline std::size_t resident_bytes()
+  {
+    #if __has_include( <malloc.h> ) && defined( __GLIBC__ )
+      ::malloc_trim( 0 );
+    #endif
+
+    std::size_t   pages = 0, residentPages = 0;
+    std::ifstream statm( "/proc/self/statm" );
+    if( !( statm >> pages >> residentPages ) ) return 0;
+
+    #if __has_include( <fcntl.h> )
+      return residentPages * static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+    #else
+      return residentPages * 4096;
+    #endif
+  }
+
+
+
+
+
+
+
+
+
+  // Count last level cache misses (hardware cache references that missed) while work() runs, this thread only and user space only.
+  // Returns -1 where hardware counters aren't available, such as on other operating systems, in many virtual machines, or when
+  // perf_event_paranoid forbids them.
+  template<typename Work>
+  long long cache_misses( Work && work )
+  {
+    #if defined( BENCHMARK_HAS_PERF_EVENTS )
+      perf_event_attr attributes{};
+      attributes.type           = PERF_TYPE_HARDWARE;
+      attributes.size           = sizeof( attributes );
+      attributes.config         = PERF_COUNT_HW_CACHE_MISSES;
+      attributes.disabled       = 1;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv     = 1;
+
+      int fd = static_cast<int>( ::syscall( SYS_perf_event_open, &attributes, 0, -1, -1, 0 ) );
+      if( fd < 0 )
+      {
+        work();
+        return -1;
+      }
+
+      ::ioctl( fd, PERF_EVENT_IOC_RESET,  0 );
+      ::ioctl( fd, PERF_EVENT_IOC_ENABLE, 0 );
+      work();
+      ::ioctl( fd, PERF_EVENT_IOC_DISABLE, 0 );
+
+      long long count = -1;
+      if( ::read( fd, &count, sizeof( count ) ) != sizeof( count ) ) count = -1;
+      ::close( fd );
+      return count;
+    #else
+      work();
+      return -1;
+    #endif
+  }
+
+
+
+
+
+
+
+
+
+  // Report one measurement as total time, time per operation, and throughput
+  inline void report( std::string_view nameOfBenchmark, std::size_t operations, double seconds, std::ostream & stream = std::clog )
+  {
+    auto flags     = stream.flags();
+    auto precision = stream.precision();
+    stream.unsetf( std::ios::showpoint );                                     // the regression tests leave showpoint set on clog
+
+    stream << "  " << std::left << std::setw( 60 ) << nameOfBenchmark << std::right << std::fixed
+           << std::setw( 12 ) << std::setprecision( 3 ) << seconds * 1e3                              << " ms"
+           << std::setw( 12 ) << std::setprecision( 1 ) << ( operations ? seconds * 1e9 / operations : 0.0 ) << " ns/op"
+           << std::setw( 14 ) << std::setprecision( 0 ) << ( seconds > 0.0 ? operations / seconds : 0.0 ) << " op/s\n";
+
+    stream.flags    ( flags     );
+    stream.precision( precision );
+  }
+
+
+
+
+  // Report one measurement as total time and bandwidth, for work whose cost is proportional to the number of bytes processed
+  inline void report_bandwidth( std::string_view nameOfBenchmark, std::size_t bytes, double seconds, std::ostream & stream = std::clog )
+  {
+    auto flags     = stream.flags();
+    auto precision = stream.precision();
+    stream.unsetf( std::ios::showpoint );
+
+    stream << "  " << std::left << std::setw( 60 ) << nameOfBenchmark << std::right << std::fixed
+           << std::setw( 12 ) << std::setprecision( 3 ) << seconds * 1e3                                  << " ms"
+           << std::setw( 12 ) << std::setprecision( 1 ) << ( seconds > 0.0 ? bytes / seconds / 1e6 : 0.0 ) << " MB/s\n";
+
+    stream.flags    ( flags     );
+    stream.precision( precision );
+  }
+
+
+
+
+  // Report one measurement as total time and memory, in total and per item
+  inline void report_memory( std::string_view nameOfBenchmark, std::size_t items, std::size_t bytes, double seconds, std::ostream & stream = std::clog )
+  {
+    auto flags     = stream.flags();
+    auto precision = stream.precision();
+    stream.unsetf( std::ios::showpoint );
+
+    stream << "  " << std::left << std::setw( 60 ) << nameOfBenchmark << std::right << std::fixed
+           << std::setw( 12 ) << std::setprecision( 3 ) << seconds * 1e3                                    << " ms"
+           << std::setw( 12 ) << std::setprecision( 1 ) << bytes / 1e6                                      << " MB"
+           << std::setw( 14 ) << std::setprecision( 1 ) << ( items ? static_cast<double>( bytes ) / items : 0.0 ) << " B/item\n";
+
+    stream.flags    ( flags     );
+    stream.precision( precision );
+  }
+
+
+
+
+  // Report one measurement as total time, time per operation, and cache misses per operation (see cache_misses(), a negative count
+  // means the counter wasn't available)
+  inline void report_cache_misses( std::string_view nameOfBenchmark, std::size_t operations, double seconds, long long misses, std::ostream & stream = std::clog )
+  {
+    auto flags     = stream.flags();
+    auto precision = stream.precision();
+    stream.unsetf( std::ios::showpoint );
+
+    stream << "  " << std::left << std::setw( 60 ) << nameOfBenchmark << std::right << std::fixed
+           << std::setw( 12 ) << std::setprecision( 3 ) << seconds * 1e3                                      << " ms"
+           << std::setw( 12 ) << std::setprecision( 1 ) << ( operations ? seconds * 1e9 / operations : 0.0 ) << " ns/op";
+    if( misses < 0 ) stream << std::setw( 14 ) << "n/a" << " misses/op\n";
+    else             stream << std::setw( 14 ) << std::setprecision( 3 ) << ( operations ? static_cast<double>( misses ) / operations : 0.0 ) << " misses/op\n";
+
+    stream.flags    ( flags     );
+    stream.precision( precision );
+  }
+}    // namespace Benchmark
@@ -0,0 +1,226 @@
+#include <algorithm>                                                          // clamp(), max(), min()
+#include <atomic>
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint64_t
+#include <deque>
+#include <exception>                                                          // exception_ptr, current_exception(), rethrow_exception()
+#include <mutex>                                                              // mutex, scoped_lock
+#include <optional>
+#include <stack>
+#include <stdexcept>                                                          // invalid_argument, out_of_range
+#include <thread>                                                             // jthread
+#include <utility>                                                            // move()
+#include <vector>
+
+#include "CartMoves.hpp"
+#include "CartMoveSimulation.hpp"
+#include "Hash.hpp"
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // Account for move number, which took item off cart from and set it on cart to, now holding height items.  The checksum is a sum,
+  // so stretches of moves add up no matter which is counted first, but each term hashes (see Hash.hpp) the move number along with
+  // the rest of the move, so the same moves in a different order would not.
+  inline void record( CartMoveStats & stats, std::uint64_t number, std::size_t item, unsigned from, unsigned to, std::size_t height ) noexcept
+  {
+    stats.checksum          += hash_of( number ^ hash_of( ( item << 4 ) | ( from << 2 ) | to ) );
+    stats.between[from][to] += 1;
+    stats.tallest[to]        = std::max( stats.tallest[to], height );
+  }
+
+
+
+  // The stats of no moves yet, from the carts as they are
+  CartMoveStats starting_from( CartContents carts )
+  {
+    CartMoveStats stats;
+    for( unsigned role = 0; role < 3; ++role ) stats.tallest[role] = carts[role].size();
+    stats.after = std::move( carts );
+    return stats;
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Merging
+*******************************************************************************/
+
+// operator+=
+CartMoveStats & CartMoveStats::operator+=( CartMoveStats const & next )
+{
+  if( next.moves == 0 ) return *this;
+  if( moves      == 0 ) return *this = next;
+  if( next.first != last + 1 ) throw std::invalid_argument( "Error - Invalid argument:  cart move stats merged out of order" );
+
+  last      = next.last;
+  moves    += next.moves;
+  checksum += next.checksum;
+  for( unsigned from = 0; from < 3; ++from ) for( unsigned to = 0; to < 3; ++to ) between[from][to] += next.between[from][to];
+  for( unsigned role = 0; role < 3; ++role ) tallest[role] = std::max( tallest[role], next.tallest[role] );
+  after = next.after;
+
+  return *this;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Simulation
+*******************************************************************************/
+
+// simulate_careful_moves( quantity )
+CartMoveStats simulate_careful_moves( std::size_t quantity )
+{
+  using Cart = std::stack<std::size_t, std::vector<std::size_t>>;
+
+  Cart carts[3];
+  for( std::size_t item = quantity; item-- > 0; ) carts[0].push( item );
+
+  auto stats = starting_from( careful_move_state( quantity, 0 ) );
+  carefully_move_iteratively( quantity, carts[0], carts[1], carts[2], [&]( CartMove const & move )
+  {
+    auto const & to = carts[move.to];
+    record( stats, ++stats.moves, to.top(), move.from, move.to, to.size() );
+  } );
+
+  for( unsigned role = 0; role < 3; ++role )
+  {
+    auto & items = stats.after[role];
+    items.resize( carts[role].size() );
+    for( auto item = items.rbegin(); item != items.rend(); ++item ) { *item = carts[role].top();  carts[role].pop(); }
+  }
+
+  if( stats.moves > 0 )
+  {
+    stats.first = 1;
+    stats.last  = stats.moves;
+  }
+  return stats;
+}
+
+
+
+
+// simulate_careful_move_segment()
+CartMoveStats simulate_careful_move_segment( std::size_t quantity, std::uint64_t first, std::uint64_t last )
+{
+  if( first == 0 || first > last || last > careful_move_count( quantity ) ) throw std::out_of_range( "Error - Out of range:  move numbers run 1 through 2^n - 1" );
+
+  auto   stats = starting_from( careful_move_state( quantity, first - 1 ) );
+  auto & carts = stats.after;
+
+  for( auto number = first; number <= last; ++number )
+  {
+    auto const move = careful_move( quantity, number );
+    auto &     from = carts[move.from];
+    auto &     to   = carts[move.to];
+
+    to.push_back( from.back() );
+    from.pop_back();
+    record( stats, number, to.back(), move.from, move.to, to.size() );
+  }
+
+  stats.first = first;
+  stats.last  = last;
+  stats.moves = last - first + 1;
+  return stats;
+}
+
+
+
+
+// simulate_careful_moves( quantity, segments, threads )
+SegmentedCartMoveStats simulate_careful_moves( std::size_t quantity, std::size_t segments, std::size_t threads )
+{
+  auto const moves = careful_move_count( quantity );
+
+  SegmentedCartMoveStats result;
+  if( moves == 0 )
+  {
+    result.total = starting_from( careful_move_state( quantity, 0 ) );
+    return result;
+  }
+
+  // Segment i is moves bounds[i] through bounds[i+1] - 1, the first moves % segments of them one move longer than the rest
+  segments = static_cast<std::size_t>( std::clamp<std::uint64_t>( segments, 1, moves ) );
+  std::vector<std::uint64_t> bounds;
+  for( std::uint64_t i = 0; i <= segments; ++i ) bounds.push_back( 1 + moves / segments * i + std::min( i, moves % segments ) );
+
+  result.segments.resize( segments );
+
+  // Simulate the segments on a work-stealing pool.  Each worker starts with a deque of its own share of the segments, consecutive
+  // ones, and works from the front of it.  A worker whose deque has run dry steals from the back of another's, so one that finishes
+  // early takes segments off the others' hands, and workers only meet on a lock when one steals.
+  {
+    struct alignas( 64 ) WorkQueue                                            // each on its own cache line
+    {
+      std::mutex              mutex;
+      std::deque<std::size_t> segments;
+    };
+
+    auto const                workerCount = std::clamp<std::size_t>( threads, 1, segments );
+    std::vector<WorkQueue>    queues( workerCount );
+    std::atomic<bool>         stop = false;
+    std::exception_ptr        failure;
+    std::mutex                failureMutex;
+    std::vector<std::jthread> workers;
+
+    for( std::size_t i = 0; i < segments; ++i ) queues[i * workerCount / segments].segments.push_back( i );
+
+    // The next segment for worker self:  the front of its own deque, or else the back of the first other deque with any left
+    auto take = [&]( std::size_t self ) -> std::optional<std::size_t>
+    {
+      for( std::size_t k = 0; k < workerCount; ++k )
+      {
+        auto &           queue = queues[( self + k ) % workerCount];
+        std::scoped_lock lock( queue.mutex );
+        if( queue.segments.empty() ) continue;
+
+        auto const segment = k == 0 ? queue.segments.front() : queue.segments.back();
+        if( k == 0 ) queue.segments.pop_front();
+        else         queue.segments.pop_back();
+        return segment;
+      }
+      return std::nullopt;                                                    // segments are never added, so every deque stays empty
+    };
+
+    auto work = [&]( std::size_t self )
+    {
+      try
+      {
+        for( auto i = take( self );  i && !stop;  i = take( self ) ) result.segments[*i] = simulate_careful_move_segment( quantity, bounds[*i], bounds[*i + 1] - 1 );
+      }
+      catch( ... )
+      {
+        std::scoped_lock lock( failureMutex );
+        if( !failure ) failure = std::current_exception();
+        stop = true;                                                          // stop the other workers early
+      }
+    };
+
+    for( std::size_t self = 0; self < workerCount; ++self ) workers.emplace_back( work, self );
+    workers.clear();                                                          // jthreads join when destroyed
+
+    if( failure ) std::rethrow_exception( failure );
+  }
+
+  // Merge in order
+  for( auto const & segment : result.segments ) result.total += segment;
+  return result;
+}
@@ -0,0 +1,55 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint64_t
+#include <vector>
+
+#include "CartMoves.hpp"
+
+
+
+
+// What carefully moving a stack of items does to the carts over a stretch of the move sequence, found by actually making the moves
+// on carts of item numbers (0 is the top item, see CartMoves.hpp) and looking at what each move really took off a cart.  The stats
+// of consecutive stretches merge into exactly the stats of the stretch they make up, so a move sequence cut into segments, simulated
+// in any order on any number of threads, and merged in order, gives what one serial run gives.
+struct CartMoveStats
+{
+  std::uint64_t first         = 0;                                            // the move numbers covered, first through last;  none if
+  std::uint64_t last          = 0;                                            // moves is 0
+  std::uint64_t moves         = 0;
+  std::uint64_t checksum      = 0;                                            // the sum of a hash of each move's number, item, and carts
+  std::uint64_t between[3][3] = {};                                           // the number of moves from cart [from] to cart [to], by role
+  std::size_t   tallest[3]    = {};                                           // the most items each cart held at once, counting the start
+  CartContents  after;                                                        // the carts after the last move
+
+  // Merge the stats of the stretch right after this one.  Throws std::invalid_argument if next doesn't start where this one ends.
+  CartMoveStats & operator+=( CartMoveStats const & next );
+
+  bool operator==( CartMoveStats const & ) const = default;
+};
+
+
+
+// Every move of quantity items, one after another, by carefully_move_iteratively():  what the segments must add up to
+CartMoveStats simulate_careful_moves( std::size_t quantity );
+
+// Moves first through last only, starting from the carts as careful_move_state( quantity, first - 1 ) has them rather than replaying
+// the moves before.  Throws std::out_of_range unless 1 <= first <= last <= careful_move_count( quantity ).
+CartMoveStats simulate_careful_move_segment( std::size_t quantity, std::uint64_t first, std::uint64_t last );
+
+
+
+// The moves of quantity items cut into segments consecutive stretches of (nearly) equal length, each simulated on its own by
+// simulate_careful_move_segment(), and the stats of each along with the total.  Up to threads workers run them on a work-stealing
+// pool:  each starts with a deque of its own share of the segments, and one whose deque runs dry steals from the back of another's,
+// so a worker that finishes early keeps taking segments off the others' hands;  cutting the moves into several segments per thread
+// balances the load.  The segments never share a cart, and merge in order, so the total is always what the serial
+// simulate_careful_moves( quantity ) would give.  Fewer segments are used if there are fewer moves.
+struct SegmentedCartMoveStats
+{
+  std::vector<CartMoveStats> segments;
+  CartMoveStats              total;
+};
+
+SegmentedCartMoveStats simulate_careful_moves( std::size_t quantity, std::size_t segments, std::size_t threads = 1 );
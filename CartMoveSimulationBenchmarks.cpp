@@ -0,0 +1,66 @@
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iostream>                                                                         // clog
+#include <string>                                                                           // to_string()
+#include <thread>                                                                           // hardware_concurrency()
+
+#include "Benchmark.hpp"
+#include "CartMoves.hpp"
+#include "CartMoveSimulation.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class CartMoveSimulationBenchmark
+  {
+    public:
+      CartMoveSimulationBenchmark();
+
+    private:
+      void simulate( std::size_t quantity );
+  } run_cartMoveSimulation_benchmarks;
+
+
+
+
+  // Simulating every move of quantity items:  serially, one move after another, vs. cut into eight segments per thread, each seeded
+  // with its starting carts directly, on more and more threads.  Any run whose stats differ from the serial run's is reported.
+  void CartMoveSimulationBenchmark::simulate( std::size_t quantity )
+  {
+    auto const moves       = careful_move_count( quantity );
+    auto const repetitions = quantity >= 26 ? 1 : 3;
+    std::clog << "\n" << quantity << " items, " << moves << " moves, " << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    CartMoveStats serial;
+    auto seconds = Benchmark::seconds( [&] { serial = simulate_careful_moves( quantity ); }, repetitions );
+    Benchmark::report( "serial, per move", moves, seconds );
+
+    for( std::size_t threads : { 1, 2, 4, 8 } )
+    {
+      SegmentedCartMoveStats parallel;
+      seconds = Benchmark::seconds( [&] { parallel = simulate_careful_moves( quantity, 8 * threads, threads ); }, repetitions );
+      Benchmark::report( std::to_string( threads ) + " thread(s), " + std::to_string( parallel.segments.size() ) + " segments, per move", moves, seconds );
+
+      if( !( parallel.total == serial ) ) std::clog << "  MISMATCH:  the segments don't add up to the serial run\n";
+    }
+  }
+
+
+
+
+  CartMoveSimulationBenchmark::CartMoveSimulationBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nCart Move Simulation Benchmarks:  Every careful move, serially vs. in parallel segments\n";
+      for( std::size_t quantity : { 16, 20, 24, 26 } ) simulate( quantity );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"CartMoveSimulation\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,119 @@
+#include <cstddef>                                                                          // size_t
+#include <cstdint>                                                                          // uint64_t
+#include <exception>
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <stdexcept>                                                                        // invalid_argument, out_of_range
+#include <vector>
+
+#include "CartMoves.hpp"
+#include "CartMoveSimulation.hpp"
+#include "CheckResults.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class CartMoveSimulationRegressionTest
+  {
+    public:
+      CartMoveSimulationRegressionTest();
+
+    private:
+      void tests();
+
+      Regression::CheckResults affirm;
+  } run_cartMoveSimulation_tests;
+
+
+
+
+  void CartMoveSimulationRegressionTest::tests()
+  {
+    // However the moves are cut into segments and however many threads simulate them, the merged stats are the serial run's
+    bool sameTotals = true, sameSegments = true, contiguous = true;
+    for( std::size_t quantity = 0; quantity <= 14; ++quantity )
+    {
+      auto const serial = simulate_careful_moves( quantity );
+
+      for( std::size_t segments : { 1, 2, 3, 7, 64, 100'000 } )
+      {
+        for( std::size_t threads : { 1, 4 } )
+        {
+          auto const parallel = simulate_careful_moves( quantity, segments, threads );
+          sameTotals = sameTotals && parallel.total == serial;
+
+          std::uint64_t next = 1;
+          for( auto const & segment : parallel.segments )
+          {
+            contiguous   = contiguous   && segment.first == next && segment.last >= segment.first && segment.moves == segment.last - segment.first + 1;
+            sameSegments = sameSegments && segment == simulate_careful_move_segment( quantity, segment.first, segment.last );
+            next         = segment.last + 1;
+          }
+          contiguous = contiguous && next == careful_move_count( quantity ) + 1 && parallel.segments.size() <= segments;
+        }
+      }
+    }
+    affirm.is_true( "Cart move simulation - segments merge to the serial run   ", sameTotals   );
+    affirm.is_true( "Cart move simulation - segments cover every move once     ", contiguous   );
+    affirm.is_true( "Cart move simulation - each segment simulated on its own  ", sameSegments );
+
+    // What the serial run found:  every item ends up on the destination, no cart ever holds more than the items being moved, the spare
+    // never all of them, and no move goes nowhere
+    {
+      std::size_t const quantity = 10;
+      auto const        serial   = simulate_careful_moves( quantity );
+      std::vector<std::size_t> all;
+      for( std::size_t item = quantity; item-- > 0; ) all.push_back( item );
+
+      affirm.is_equal( "Cart move simulation - moves                              ", careful_move_count( quantity ), serial.moves );
+      affirm.is_true ( "Cart move simulation - carts after the last move          ", serial.after[0].empty() && serial.after[1] == all && serial.after[2].empty() );
+      affirm.is_true ( "Cart move simulation - tallest carts                      ", serial.tallest[0] == quantity && serial.tallest[1] == quantity && serial.tallest[2] == quantity - 1 );
+      affirm.is_equal( "Cart move simulation - never a move onto the same cart    ", std::uint64_t{ 0 }, serial.between[0][0] + serial.between[1][1] + serial.between[2][2] );
+
+      std::uint64_t between = 0;
+      for( auto const & from : serial.between ) for( auto count : from ) between += count;
+      affirm.is_equal( "Cart move simulation - every move between two carts       ", serial.moves, between );
+    }
+
+    // Two halves merge into the whole, but the checksum tells apart sequences with the same moves in a different order (odd and even
+    // numbers of items move the same items between the same carts, just with the destination and spare traded)
+    {
+      auto merged = simulate_careful_move_segment( 6, 1, 31 );
+      merged += simulate_careful_move_segment( 6, 32, 63 );
+      affirm.is_true     ( "Cart move simulation - halves merge into the whole        ", merged == simulate_careful_moves( 6 ) );
+      affirm.is_not_equal( "Cart move simulation - checksum depends on the moves      ", simulate_careful_moves( 6 ).checksum, simulate_careful_moves( 7 ).checksum );
+    }
+
+    bool outOfOrder = false, outOfRange = false;
+    try                                     { auto stats = simulate_careful_move_segment( 5, 1, 4 );  stats += simulate_careful_move_segment( 5, 6, 9 ); }
+    catch( std::invalid_argument const & )  { outOfOrder = true; }
+    try                                     { simulate_careful_move_segment( 5, 30, 32 ); }
+    catch( std::out_of_range const & )      { outOfRange = true; }
+    affirm.is_true( "Cart move simulation - merging out of order throws        ", outOfOrder );
+    affirm.is_true( "Cart move simulation - moves past the last throw          ", outOfRange );
+  }
+
+
+
+
+  CartMoveSimulationRegressionTest::CartMoveSimulationRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nCart Move Simulation Regression Test:\n";
+      tests();
+
+      std::clog << "\n\nCart Move Simulation Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"CartMoveSimulation\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,271 @@
+#pragma once                                                                  // include guard
+
+#include <array>
+#include <bit>                                                                // countr_zero()
+#include <cstddef>                                                            // size_t, ptrdiff_t
+#include <cstdint>                                                            // uint64_t
+#include <ranges>                                                             // view_interface
+#include <stdexcept>                                                          // invalid_argument, length_error, out_of_range
+#include <utility>                                                            // move(), swap()
+#include <vector>
+
+
+
+
+// Carefully moving grocery items from one cart to another (the Tower of Hanoi):  a stack of items is moved one item at a time,
+// through a spare cart, never setting an item on top of one that was above it to begin with.  It takes 2^n - 1 moves for n items,
+// and there is exactly one way to do it in that many.
+//
+// The carts are any stack-like containers (top(), push(), pop(), size(), empty()), of grocery items or of handles to them (see
+// GroceryItemPool).  Items are moved, never copied.  A cart is identified by its role:
+//
+//     0  the source cart, where the items start
+//     1  the destination cart, where they end up
+//     2  the spare cart
+constexpr std::size_t MAXIMUM_CAREFUL_MOVE_ITEMS = 63;                        // 2^63 - 1 moves still fit in std::uint64_t
+
+
+
+// One move:  item (0 is the top item of the stack being moved, n-1 the bottom one) moves from cart from to cart to
+struct CartMove
+{
+  std::size_t item;
+  unsigned    from;
+  unsigned    to;
+
+  constexpr bool operator==( CartMove const & ) const noexcept = default;
+};
+
+
+
+// The number of moves it takes to carefully move quantity items
+constexpr std::uint64_t careful_move_count( std::size_t quantity )
+{
+  if( quantity > MAXIMUM_CAREFUL_MOVE_ITEMS ) throw std::length_error( "Error - Length error:  too many grocery items to count the moves" );
+  return ( std::uint64_t{ 1 } << quantity ) - 1;
+}
+
+
+
+// Position around the circle of carts (see careful_move()) to role, for an even and for an odd number of items
+constexpr unsigned CAREFUL_MOVE_ROLES[2][3] = { { 0, 1, 2 }, { 0, 2, 1 } };
+
+
+
+// Move number move (1 through careful_move_count( quantity )), computed directly from its bits without replaying the moves before
+// it.  The item moved is the number of trailing zeros of move:  the top item every other move, the next one every fourth, and so on.
+// The carts follow from the bits above and below that item's bit, counting carts around in a circle that runs source, spare,
+// destination for an odd number of items, and source, destination, spare for an even number.
+constexpr CartMove careful_move( std::size_t quantity, std::uint64_t move ) noexcept
+{
+  auto const & roles = CAREFUL_MOVE_ROLES[quantity % 2];
+
+  return { static_cast<std::size_t>( std::countr_zero( move ) ),
+           roles[( move & ( move - 1 ) ) % 3],
+           roles[( ( move | ( move - 1 ) ) + 1 ) % 3] };
+}
+
+
+
+// The role of the cart holding item (0 is the top item) once move number move has been made, 0 meaning before any move, again
+// without replaying the moves before it.  Each item keeps moving the same way around the circle, the top item backwards, the next
+// forwards, and so on, and by then has moved once for every time move has passed an odd multiple of its bit.
+constexpr unsigned careful_move_cart( std::size_t quantity, std::size_t item, std::uint64_t move ) noexcept
+{
+  auto const     moved    = static_cast<unsigned>( ( ( move >> item ) + 1 ) / 2 % 3 );
+  unsigned const position = item % 2 == 0 ? ( 3 - moved ) % 3 : moved;
+
+  return CAREFUL_MOVE_ROLES[quantity % 2][position];
+}
+
+
+
+// The three carts once move number move has been made, indexed by role, each holding the items (0 is the top item of the stack being
+// moved) from the bottom of the cart up.  Move 0 is before any move, matching the move numbers trace() prints in main.cpp, so the
+// state after move k can be compared with "After k moves" directly.  O(quantity).  Throws std::out_of_range for a move number past
+// the last move, and std::length_error for more than MAXIMUM_CAREFUL_MOVE_ITEMS.
+using CartContents = std::array<std::vector<std::size_t>, 3>;
+
+inline CartContents careful_move_state( std::size_t quantity, std::uint64_t move )
+{
+  if( move > careful_move_count( quantity ) ) throw std::out_of_range( "Error - Out of range:  move number past the last move" );
+
+  CartContents carts;
+  for( std::size_t item = quantity; item-- > 0; ) carts[careful_move_cart( quantity, item, move )].push_back( item );
+  return carts;
+}
+
+
+
+// A move and its number, 1 through careful_move_count( quantity )
+struct NumberedCartMove
+{
+  std::uint64_t number;
+  CartMove      move;
+
+  constexpr bool operator==( NumberedCartMove const & ) const noexcept = default;
+};
+
+
+
+// A lazy range over moves first through last, computing each as it is reached (see careful_move()) instead of storing any, so a
+// stretch of a move sequence far too long to replay or keep can still be walked.  Move numbers match trace() in main.cpp.
+class CarefulMoves : public std::ranges::view_interface<CarefulMoves>
+{
+  public:
+    class iterator
+    {
+      friend class CarefulMoves;
+
+      public:
+        using value_type      = NumberedCartMove;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        NumberedCartMove operator* ()    const noexcept { return { _number, careful_move( _quantity, _number ) }; }
+        iterator &       operator++()          noexcept { ++_number;  return *this; }
+        iterator         operator++( int )     noexcept { auto previous = *this;  ++_number;  return previous; }
+
+        constexpr bool operator==( iterator const & ) const noexcept = default;
+
+      private:
+        iterator( std::size_t quantity, std::uint64_t number ) noexcept : _quantity( quantity ), _number( number ) {}
+
+        std::size_t   _quantity = 0;
+        std::uint64_t _number   = 0;
+    };
+
+    // Every move, or moves first through last (empty if first > last).  Throws std::out_of_range unless 1 <= first and
+    // last <= careful_move_count( quantity ), and std::length_error for more than MAXIMUM_CAREFUL_MOVE_ITEMS.
+    explicit CarefulMoves( std::size_t quantity )
+      : CarefulMoves( quantity, 1, careful_move_count( quantity ) )
+    {}
+
+    CarefulMoves( std::size_t quantity, std::uint64_t first, std::uint64_t last )
+      : _quantity( quantity ), _first( first > last ? last + 1 : first ), _last( last )
+    {
+      if( first == 0 || last > careful_move_count( quantity ) ) throw std::out_of_range( "Error - Out of range:  move numbers run 1 through 2^n - 1" );
+    }
+
+    iterator    begin() const noexcept { return { _quantity, _first    }; }
+    iterator    end  () const noexcept { return { _quantity, _last + 1 }; }
+    std::size_t size () const noexcept { return static_cast<std::size_t>( _last + 1 - _first ); }
+
+  private:
+    std::size_t   _quantity;
+    std::uint64_t _first;
+    std::uint64_t _last;
+};
+
+
+
+
+// The classic recursive algorithm, one level of recursion per item, as originally given:
+//
+//    Procedure carefully_move_grocery_items (number_of_items_to_be_moved, broken_cart, working_cart, spare_cart)
+//       IF number_of_items_to_be_moved == 1, THEN
+//          move top item from broken_cart to working_cart
+//          trace the move
+//       ELSE
+//          carefully_move_grocery_items (number_of_items_to_be_moved-1, broken_cart, spare_cart, working_cart)
+//          move top item from broken_cart to working_cart
+//          trace the move
+//          carefully_move_grocery_items (number_of_items_to_be_moved-1, spare_cart, working_cart, broken_cart)
+//       END IF
+//    END Procedure
+//
+// observe( source, destination, spare ) is called after every move, with the carts in the order of that level of the recursion.
+template<typename Cart, typename Observer>
+void carefully_move_recursively( std::size_t quantity, Cart & source, Cart & destination, Cart & spare, Observer && observe )
+{
+  if( quantity == 0 ) return;
+
+  carefully_move_recursively( quantity - 1, source, spare, destination, observe );
+  destination.push( std::move( source.top() ) );
+  source.pop();
+  observe( source, destination, spare );
+  carefully_move_recursively( quantity - 1, spare, destination, source, observe );
+}
+
+
+
+// The same moves in the same order, in a loop instead:  no recursion, no allocation beyond what pushing onto the carts takes, and
+// each move computed from its number (see careful_move()), or for the top item, which moves every other time, one step further
+// around the circle than it last did.  observe( CartMove ) is called after every move.  Throws
+// std::invalid_argument if source holds fewer than quantity items, and std::length_error for more than MAXIMUM_CAREFUL_MOVE_ITEMS.
+template<typename Cart, typename Observer>
+void carefully_move_iteratively( std::size_t quantity, Cart & source, Cart & destination, Cart & spare, Observer && observe )
+{
+  if( quantity > source.size() ) throw std::invalid_argument( "Error - Invalid argument:  fewer grocery items in the cart than asked to move" );
+
+  Cart * const carts[3] = { &source, &destination, &spare };
+  auto const   moves    = careful_move_count( quantity );
+  auto const & roles    = CAREFUL_MOVE_ROLES[quantity % 2];
+  unsigned     top      = 0;                                                  // the top item's position around the circle, which it walks backwards
+
+  for( std::uint64_t move = 1; move <= moves; ++move )
+  {
+    CartMove step;
+    if( move % 2 == 1 )
+    {
+      unsigned const next = top == 0 ? 2 : top - 1;
+      step = { 0, roles[top], roles[next] };
+      top  = next;
+    }
+    else step = careful_move( quantity, move );
+
+    auto & from = *carts[step.from];
+
+    carts[step.to]->push( std::move( from.top() ) );
+    from.pop();
+    observe( step );
+  }
+}
+
+template<typename Cart>
+void carefully_move_iteratively( std::size_t quantity, Cart & source, Cart & destination, Cart & spare )
+{
+  carefully_move_iteratively( quantity, source, destination, spare, []( CartMove const & ) {} );
+}
+
+
+
+// Skip straight to where every move would leave the carts:  the top quantity items of source on top of destination, in the same
+// order, and spare as it was.  A whole cart moved onto an empty one is just swapped, in constant time, otherwise each item is moved
+// twice, by way of spare.  Same exceptions as carefully_move_iteratively(), except there is no limit on quantity.
+template<typename Cart>
+void carefully_move_directly( std::size_t quantity, Cart & source, Cart & destination, Cart & spare )
+{
+  if( quantity > source.size() ) throw std::invalid_argument( "Error - Invalid argument:  fewer grocery items in the cart than asked to move" );
+
+  if( quantity == source.size() && destination.empty() )
+  {
+    using std::swap;
+    swap( source, destination );
+    return;
+  }
+
+  for( std::size_t i = 0; i < quantity; ++i ) { spare      .push( std::move( source.top() ) );  source.pop(); }
+  for( std::size_t i = 0; i < quantity; ++i ) { destination.push( std::move( spare .top() ) );  spare .pop(); }
+}
+
+
+
+// Skip straight to where move number move (0 meaning before any move) would leave the carts, from the top quantity items of source,
+// in O(quantity) moves of the items rather than up to 2^quantity - 1.  Same exceptions as carefully_move_iteratively(), plus
+// std::out_of_range for a move number past the last move.
+template<typename Cart>
+void carefully_move_to( std::size_t quantity, std::uint64_t move, Cart & source, Cart & destination, Cart & spare )
+{
+  if( quantity > source.size()                  ) throw std::invalid_argument( "Error - Invalid argument:  fewer grocery items in the cart than asked to move" );
+  if( move     > careful_move_count( quantity ) ) throw std::out_of_range    ( "Error - Out of range:  move number past the last move" );
+
+  std::vector<typename Cart::value_type> items;                               // items[0] is the top item
+  items.reserve( quantity );
+  for( std::size_t i = 0; i < quantity; ++i ) { items.push_back( std::move( source.top() ) );  source.pop(); }
+
+  // Bottom item first, so each cart ends up with its items in their original order
+  Cart * const carts[3] = { &source, &destination, &spare };
+  for( std::size_t item = quantity; item-- > 0; ) carts[careful_move_cart( quantity, item, move )]->push( std::move( items[item] ) );
+}
@@ -0,0 +1,120 @@
+#include <cstddef>                                                                          // size_t
+#include <cstdint>                                                                          // uint64_t
+#include <exception>
+#include <iostream>                                                                         // clog
+#include <stack>
+#include <string>
+
+#include "Benchmark.hpp"
+#include "CartMoves.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemPool.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class CartMovesBenchmark
+  {
+    public:
+      CartMovesBenchmark();
+
+    private:
+      void moves( std::size_t quantity );
+  } run_cartMoves_benchmarks;
+
+
+
+
+  // Carefully moving a cart of quantity items:  recursively and iteratively, every move, on carts of handles, and directly to the
+  // final carts.  The recursive algorithm on carts of grocery items, copying each one as main() used to, only while it's quick.
+  void CartMovesBenchmark::moves( std::size_t quantity )
+  {
+    GroceryItemPool pool;
+    GroceryCart     loaded;
+    for( std::size_t i = 0; i < quantity; ++i ) loaded.push( pool.add( GroceryItem( "Grocery Item With A Long Product Name " + std::to_string( i ), "Brand", std::to_string( 10'000'000'000'000 + i ), 1.99 ) ) );
+
+    auto const moves       = careful_move_count( quantity );
+    auto const repetitions = quantity >= 25 ? 1 : 3;
+    std::clog << "\n" << quantity << " items, " << moves << " moves\n";
+
+    if( quantity <= 20 )
+    {
+      std::stack<GroceryItem> source;
+      for( auto copy = loaded; !copy.empty(); copy.pop() ) source.push( pool[copy.top()] );
+      auto seconds = Benchmark::seconds( [&]
+      {
+        auto from = source;
+        decltype( from ) to, other;
+        carefully_move_recursively( quantity, from, to, other, []( auto &, auto & onto, auto & ) { Benchmark::do_not_optimize( onto.size() ); } );
+      }, repetitions );
+      Benchmark::report( "recursive, grocery items, per move", moves, seconds );
+    }
+
+    auto seconds = Benchmark::seconds( [&]
+    {
+      GroceryCart from = loaded, to, other;
+      carefully_move_recursively( quantity, from, to, other, []( auto &, auto & onto, auto & ) { Benchmark::do_not_optimize( onto.size() ); } );
+    }, repetitions );
+    Benchmark::report( "recursive, handles, per move", moves, seconds );
+
+    seconds = Benchmark::seconds( [&]
+    {
+      GroceryCart from = loaded, to, other;
+      carefully_move_iteratively( quantity, from, to, other, []( CartMove const & move ) { Benchmark::do_not_optimize( move.item ); } );
+    }, repetitions );
+    Benchmark::report( "iterative, handles, per move", moves, seconds );
+
+    seconds = Benchmark::seconds( [&]
+    {
+      GroceryCart from = loaded, to, other;
+      carefully_move_directly( quantity, from, to, other );
+      Benchmark::do_not_optimize( to.size() );
+    } );
+    Benchmark::report( "directly to the final carts (not per move)", 1, seconds );
+
+    // The carts halfway through, just before the bottom item moves:  replaying each move from the lazy range, vs. skipping straight
+    // there, or just computing which item is where
+    auto const halfway = moves / 2;
+    seconds = Benchmark::seconds( [&]
+    {
+      GroceryCart carts[3] = { loaded, {}, {} };
+      for( auto const & step : CarefulMoves( quantity, 1, halfway ) )
+      {
+        carts[step.move.to].push( carts[step.move.from].top() );
+        carts[step.move.from].pop();
+      }
+      Benchmark::do_not_optimize( carts[2].size() );
+    }, repetitions );
+    Benchmark::report( "lazy range replayed to halfway, per move", halfway, seconds );
+
+    seconds = Benchmark::seconds( [&]
+    {
+      GroceryCart from = loaded, to, other;
+      carefully_move_to( quantity, halfway, from, to, other );
+      Benchmark::do_not_optimize( other.size() );
+    } );
+    Benchmark::report( "skipping straight to halfway (not per move)", 1, seconds );
+
+    seconds = Benchmark::seconds( [&] { Benchmark::do_not_optimize( careful_move_state( quantity, halfway )[2].size() ); } );
+    Benchmark::report( "state halfway, computed directly (not per move)", 1, seconds );
+  }
+
+
+
+
+  CartMovesBenchmark::CartMovesBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nCart Moves Benchmarks:  Carefully moving grocery items, recursively vs. iteratively, and skipping to any move\n";
+      for( std::size_t quantity : { 10, 15, 20, 25, 30 } ) moves( quantity );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"CartMoves\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,223 @@
+#include <algorithm>                                                                        // min()
+#include <cstddef>                                                                          // size_t, ptrdiff_t
+#include <cstdint>                                                                          // uint64_t
+#include <exception>
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <ranges>                                                                           // equal(), forward_range, view
+#include <stack>
+#include <stdexcept>                                                                        // invalid_argument, length_error, out_of_range
+#include <vector>
+
+#include "CartMoves.hpp"
+#include "CheckResults.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class CartMovesRegressionTest
+  {
+    public:
+      CartMovesRegressionTest();
+
+    private:
+      void tests();
+
+      Regression::CheckResults affirm;
+  } run_cartMoves_tests;
+
+
+
+
+  using Cart = std::stack<std::size_t>;
+
+  // A cart of quantity items, numbered from the top:  0 on top and quantity-1 on the bottom, plus extra items beneath them
+  Cart loaded_cart( std::size_t quantity, std::size_t extra = 0 )
+  {
+    Cart cart;
+    for( std::size_t item = quantity + extra; item-- > 0; ) cart.push( item );
+    return cart;
+  }
+
+
+
+
+  // A cart's items from the bottom up
+  std::vector<std::size_t> contents( Cart cart )
+  {
+    std::vector<std::size_t> items( cart.size() );
+    for( auto item = items.rbegin(); item != items.rend(); ++item ) { *item = cart.top();  cart.pop(); }
+    return items;
+  }
+
+  // The items on a cart of quantity items to be moved with extra items beneath them, from the bottom up
+  std::vector<std::size_t> with_extra( std::vector<std::size_t> const & items, std::size_t quantity, std::size_t extra )
+  {
+    std::vector<std::size_t> all;
+    for( std::size_t item = quantity + extra; item-- > quantity; ) all.push_back( item );
+    all.insert( all.end(), items.begin(), items.end() );
+    return all;
+  }
+
+
+
+
+  void CartMovesRegressionTest::tests()
+  {
+    // The iterative moves are the recursive moves, in the same order, for odd and even numbers of items alike
+    bool sameMoves = true, neverOnSmaller = true, allMoved = true;
+    for( std::size_t quantity = 0; quantity <= 12; ++quantity )
+    {
+      std::vector<CartMove> expected, actual;
+      {
+        Cart carts[3] = { loaded_cart( quantity ), {}, {} };
+        auto role     = [&]( Cart const & cart ) { return static_cast<unsigned>( &cart - carts ); };
+        carefully_move_recursively( quantity, carts[0], carts[1], carts[2], [&]( Cart const & from, Cart const & to, Cart const & )
+        {
+          expected.push_back( { to.top(), role( from ), role( to ) } );
+        } );
+      }
+
+      Cart carts[3] = { loaded_cart( quantity ), {}, {} };
+      carefully_move_iteratively( quantity, carts[0], carts[1], carts[2], [&]( CartMove const & move )
+      {
+        actual.push_back( move );
+        auto & to = carts[move.to];
+        neverOnSmaller = neverOnSmaller && to.top() == move.item;
+        if( to.size() > 1 )
+        {
+          to.pop();
+          neverOnSmaller = neverOnSmaller && to.top() > move.item;
+          to.push( move.item );
+        }
+      } );
+
+      sameMoves = sameMoves && expected == actual && actual.size() == careful_move_count( quantity );
+      allMoved  = allMoved  && carts[0].empty() && carts[2].empty() && carts[1] == loaded_cart( quantity );
+    }
+    affirm.is_true( "Careful moves - iterative moves are the recursive moves   ", sameMoves      );
+    affirm.is_true( "Careful moves - never an item on a smaller one            ", neverOnSmaller );
+    affirm.is_true( "Careful moves - every item ends up on the destination     ", allMoved       );
+
+    // Moving only the top of a cart leaves the rest, and the spare, alone
+    {
+      Cart source = loaded_cart( 5, 3 ), destination, spare;
+      destination.push( 100 );
+      carefully_move_iteratively( 5, source, destination, spare );
+
+      Cart directSource = loaded_cart( 5, 3 ), directDestination, directSpare;
+      directDestination.push( 100 );
+      carefully_move_directly( 5, directSource, directDestination, directSpare );
+
+      affirm.is_true( "Careful moves - top of a cart, onto a nonempty cart        ", source.size() == 3 && source.top() == 5 && destination.size() == 6 && destination.top() == 0 && spare.empty() );
+      affirm.is_true( "Careful moves - moving directly ends the same way          ", source == directSource && destination == directDestination && spare == directSpare );
+    }
+
+    {
+      Cart source = loaded_cart( 40 ), destination, spare;
+      carefully_move_directly( 40, source, destination, spare );
+      affirm.is_true( "Careful moves - whole cart directly, past the move limit   ", source.empty() && spare.empty() && destination == loaded_cart( 40 ) );
+    }
+
+    // Any one move, straight from its number, far beyond what could be replayed:  the bottom of 40 items moves exactly once, halfway
+    // through, from source to destination, and the last move sets the top item onto the destination from the spare
+    affirm.is_true( "Careful moves - move k computed directly                   ", careful_move( 40, std::uint64_t{ 1 } << 39 ) == CartMove{ 39, 0, 1 }
+                                                                                     && careful_move( 40, ( std::uint64_t{ 1 } << 40 ) - 1 ) == CartMove{ 0, 2, 1 } );
+
+    // The carts after any move, computed directly, are the carts that replaying every move up to it leaves, numbered as trace() in
+    // main.cpp numbers them:  move 0 before any move, move k after the k-th
+    bool sameStates = true, sameSkips = true, sameRanges = true;
+    for( std::size_t quantity = 0; quantity <= 10; ++quantity )
+    {
+      std::vector<NumberedCartMove> moves;
+      Cart carts[3] = { loaded_cart( quantity, 2 ), {}, {} };
+      auto same     = [&]( std::uint64_t number )
+      {
+        auto const state = careful_move_state( quantity, number );
+        sameStates = sameStates && contents( carts[0] ) == with_extra( state[0], quantity, 2 ) && contents( carts[1] ) == state[1] && contents( carts[2] ) == state[2];
+
+        Cart skipped[3] = { loaded_cart( quantity, 2 ), {}, {} };
+        carefully_move_to( quantity, number, skipped[0], skipped[1], skipped[2] );
+        sameSkips = sameSkips && skipped[0] == carts[0] && skipped[1] == carts[1] && skipped[2] == carts[2];
+      };
+
+      same( 0 );
+      carefully_move_iteratively( quantity, carts[0], carts[1], carts[2], [&]( CartMove const & move )
+      {
+        moves.push_back( { moves.size() + 1, move } );
+        same( moves.size() );
+      } );
+
+      CarefulMoves const            every( quantity );
+      std::vector<NumberedCartMove> all;
+      for( auto const & move : every ) all.push_back( move );
+      sameRanges = sameRanges && all == moves && every.size() == moves.size();
+
+      for( std::uint64_t first = 1; first <= moves.size(); first += 3 )
+      {
+        std::uint64_t const           last = std::min<std::uint64_t>( first + 4, moves.size() );
+        std::vector<NumberedCartMove> some;
+        for( auto const & move : CarefulMoves( quantity, first, last ) ) some.push_back( move );
+        sameRanges = sameRanges && std::ranges::equal( some, std::vector<NumberedCartMove>( moves.begin() + static_cast<std::ptrdiff_t>( first - 1 ), moves.begin() + static_cast<std::ptrdiff_t>( last ) ) );
+      }
+    }
+    affirm.is_true( "Careful moves - state after move k computed directly       ", sameStates );
+    affirm.is_true( "Careful moves - skipping to move k                         ", sameSkips  );
+    affirm.is_true( "Careful moves - lazy range of moves                        ", sameRanges && std::ranges::forward_range<CarefulMoves> && std::ranges::view<CarefulMoves> );
+    affirm.is_true( "Careful moves - empty range of moves                       ", CarefulMoves( 4, 6, 5 ).empty() && CarefulMoves( 0 ).empty() && CarefulMoves( 4, 1, 0 ).empty() );
+    affirm.is_true( "Careful moves - empty range starting past the last move    ", CarefulMoves( 4, 16, 5 ).empty() && CarefulMoves( 4, 17, 5 ).empty() && CarefulMoves( 4, 17, 5 ).size() == 0 );
+
+    // Far beyond what could be replayed:  just before the bottom of 40 items moves, the rest are all on the spare, and just after,
+    // it has joined them on the destination
+    {
+      std::uint64_t const half  = std::uint64_t{ 1 } << 39;
+      auto const          above = careful_move_state( 40, half );
+      auto const          below = careful_move_state( 40, half - 1 );
+      affirm.is_true( "Careful moves - state after move k, past the move limit    ", below[0] == std::vector<std::size_t>{ 39 } && below[1].empty() && below[2].size() == 39
+                                                                                     && above[0].empty() && above[1] == std::vector<std::size_t>{ 39 } && above[2] == below[2] );
+    }
+
+    bool pastLast = false, moveZero = false, lastPastLast = false;
+    try                                     { careful_move_state( 3, 8 ); }
+    catch( std::out_of_range const & )      { pastLast = true; }
+    try                                     { CarefulMoves( 3, 0, 2 ); }
+    catch( std::out_of_range const & )      { moveZero = true; }
+    try                                     { CarefulMoves( 4, 17, 16 ); }
+    catch( std::out_of_range const & )      { lastPastLast = true; }
+    affirm.is_true( "Careful moves - state past the last move throws            ", pastLast );
+    affirm.is_true( "Careful moves - move number 0 throws                       ", moveZero );
+    affirm.is_true( "Careful moves - range ending past the last move throws     ", lastPastLast );
+
+    bool tooFew = false, tooMany = false;
+    try                                     { Cart source = loaded_cart( 2 ), destination, spare;  carefully_move_iteratively( 3, source, destination, spare ); }
+    catch( std::invalid_argument const & )  { tooFew = true; }
+    try                                     { careful_move_count( MAXIMUM_CAREFUL_MOVE_ITEMS + 1 ); }
+    catch( std::length_error const & )      { tooMany = true; }
+    affirm.is_true( "Careful moves - too few items throws                       ", tooFew  );
+    affirm.is_true( "Careful moves - too many items to count throws             ", tooMany );
+  }
+
+
+
+
+  CartMovesRegressionTest::CartMovesRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nCart Moves Regression Test:\n";
+      tests();
+
+      std::clog << "\n\nCart Moves Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"CartMoves\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
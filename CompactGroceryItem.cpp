@@ -0,0 +1,253 @@
+#include <compare>                                                            // weak_ordering
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint8_t, uint32_t
+#include <cstring>                                                            // memcpy()
+#include <iomanip>                                                            // quoted()
+#include <iostream>                                                           // ostream
+#include <limits>                                                             // numeric_limits
+#include <memory_resource>                                                    // memory_resource
+#include <stdexcept>                                                          // invalid_argument, length_error
+#include <string>                                                             // to_string()
+#include <string_view>
+#include <type_traits>                                                        // is_trivially_copyable_v, is_trivially_destructible_v
+
+#include "CompactGroceryItem.hpp"
+#include "GroceryItem.hpp"
+#include "Money.hpp"
+
+
+
+static_assert( std::is_trivially_copyable_v    <CompactGroceryItem>, "copying a compact grocery item must be a memcpy" );
+static_assert( std::is_trivially_destructible_v<CompactGroceryItem>, "a compact grocery item must own nothing"         );
+static_assert( sizeof( CompactGroceryItem ) == 64,                   "a compact grocery item should fill one cache line" );
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Names
+*******************************************************************************/
+
+// Name( text, arena )
+CompactGroceryItem::Name::Name( std::string_view text, std::pmr::memory_resource * arena )
+{
+  if( text.size() <= INLINE_CAPACITY )
+  {
+    std::memcpy( _bytes, text.data(), text.size() );
+    _bytes[sizeof( _bytes ) - 1] = static_cast<char>( text.size() );
+    return;
+  }
+
+  if( text.size() > std::numeric_limits<std::uint32_t>::max() ) throw std::length_error( "Error - Length error:  grocery item name longer than 4 GiB" );
+  if( arena == nullptr ) throw std::invalid_argument( "Error - Invalid argument:  grocery item name longer than " + std::to_string( INLINE_CAPACITY ) + " characters with no arena to hold it" );
+
+  auto const data   = static_cast<char *>( arena->allocate( text.size(), 1 ) );
+  auto const length = static_cast<std::uint32_t>( text.size() );
+  std::memcpy( data, text.data(), text.size() );
+
+  std::memcpy( _bytes,                 &data,   sizeof( data   ) );
+  std::memcpy( _bytes + sizeof( data ), &length, sizeof( length ) );
+  _bytes[sizeof( _bytes ) - 1] = static_cast<char>( ARENA );
+}
+
+
+
+
+// view()
+std::string_view CompactGroceryItem::Name::view() const noexcept
+{
+  if( is_inline() ) return { _bytes, static_cast<unsigned char>( _bytes[sizeof( _bytes ) - 1] ) };
+
+  char const *  data;
+  std::uint32_t length;
+  std::memcpy( &data,   _bytes,                 sizeof( data   ) );
+  std::memcpy( &length, _bytes + sizeof( data ), sizeof( length ) );
+  return { data, length };
+}
+
+
+
+
+// is_inline()
+bool CompactGroceryItem::Name::is_inline() const noexcept
+{
+  return static_cast<unsigned char>( _bytes[sizeof( _bytes ) - 1] ) != ARENA;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors and conversions
+*******************************************************************************/
+
+// Constructor from a price in cents
+CompactGroceryItem::CompactGroceryItem( std::string_view productName, std::string_view brandName, std::string_view upcCode, Money price, std::pmr::memory_resource * arena )
+  : _brandName( brandName, arena ), _productName( productName, arena ), _price( price )
+{
+  if( upcCode.size() > UPC_CAPACITY ) throw std::length_error( "Error - Length error:  UPC code longer than " + std::to_string( UPC_CAPACITY ) + " characters" );
+
+  std::memcpy( _upcCode, upcCode.data(), upcCode.size() );
+  _upcLength = static_cast<std::uint8_t>( upcCode.size() );
+}
+
+
+
+
+// Constructor from a price in dollars
+CompactGroceryItem::CompactGroceryItem( std::string_view productName, std::string_view brandName, std::string_view upcCode, double price, std::pmr::memory_resource * arena )
+  : CompactGroceryItem( productName, brandName, upcCode, Money( price ), arena )
+{}
+
+
+
+
+// Conversion from GroceryItem
+CompactGroceryItem::CompactGroceryItem( GroceryItem const & groceryItem, std::pmr::memory_resource * arena )
+  : CompactGroceryItem( groceryItem.productName(), groceryItem.brandName(), groceryItem.upcCode(), groceryItem.exactPrice(), arena )
+{}
+
+
+
+
+// Conversion to GroceryItem
+CompactGroceryItem::operator GroceryItem() const
+{
+  return GroceryItem( productName(), brandName(), upcCode(), _price );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Accessors
+*******************************************************************************/
+
+// upcCode()
+std::string_view CompactGroceryItem::upcCode() const noexcept
+{
+  return { _upcCode, _upcLength };
+}
+
+
+
+
+// brandName()
+std::string_view CompactGroceryItem::brandName() const noexcept
+{
+  return _brandName.view();
+}
+
+
+
+
+// productName()
+std::string_view CompactGroceryItem::productName() const noexcept
+{
+  return _productName.view();
+}
+
+
+
+
+// price()
+double CompactGroceryItem::price() const noexcept
+{
+  return _price.dollars();
+}
+
+
+
+
+// exactPrice()
+Money CompactGroceryItem::exactPrice() const noexcept
+{
+  return _price;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// price( dollars )
+CompactGroceryItem & CompactGroceryItem::price( double newPrice ) & noexcept
+{
+  _price = Money( newPrice );
+  return *this;
+}
+
+
+
+
+// price( cents )
+CompactGroceryItem & CompactGroceryItem::price( Money newPrice ) & noexcept
+{
+  _price = newPrice;
+  return *this;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Relational Operators
+*******************************************************************************/
+
+// operator<=>(...)
+std::weak_ordering CompactGroceryItem::operator<=>( CompactGroceryItem const & rhs ) const noexcept
+{
+  // The same order as GroceryItem:  UPC code, product name, brand name, then price
+  if( auto cmp = upcCode    () <=> rhs.upcCode    (); cmp != 0 ) return cmp;
+  if( auto cmp = productName() <=> rhs.productName(); cmp != 0 ) return cmp;
+  if( auto cmp = brandName  () <=> rhs.brandName  (); cmp != 0 ) return cmp;
+  return _price <=> rhs._price;
+}
+
+
+
+
+// operator==(...)
+bool CompactGroceryItem::operator==( CompactGroceryItem const & rhs ) const noexcept
+{
+  return _price == rhs._price && upcCode() == rhs.upcCode() && productName() == rhs.productName() && brandName() == rhs.brandName();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Insertion Operator
+*******************************************************************************/
+
+// operator<<(...)
+std::ostream & operator<<( std::ostream & stream, CompactGroceryItem const & groceryItem )
+{
+  return stream << std::quoted( groceryItem.upcCode() ) << ", " << std::quoted( groceryItem.brandName() ) << ", " << std::quoted( groceryItem.productName() ) << ", " << groceryItem._price;
+}
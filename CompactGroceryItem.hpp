@@ -0,0 +1,96 @@
+#pragma once                                                                  // include guard
+
+#include <compare>                                                            // weak_ordering
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint8_t
+#include <iostream>                                                           // ostream
+#include <memory_resource>                                                    // memory_resource
+#include <string_view>
+
+#include "GroceryItem.hpp"
+#include "Money.hpp"
+
+
+
+
+// A grocery item that owns no memory, for code that copies grocery items around by value (Ex: carts of them, or snapshots of those
+// carts) rather than keeping them in one place.  A GroceryItem holds three strings, and copying one may allocate for each string
+// too long for its small string buffer (Ex: most product names).  A CompactGroceryItem is trivially copyable instead:  copying or
+// moving one is a 64 byte memcpy, and destroying one is nothing at all.
+//
+//   o  The UPC code is held inline, up to UPC_CAPACITY characters.  That covers every UPC (at most 17 digits) and the odd code
+//      that isn't all digits.
+//   o  A brand or product name of up to Name::INLINE_CAPACITY characters (most brands) is held inline as well.  A longer one is
+//      copied once, at construction, into an arena, and every copy of the item shares it.
+//
+// The caller provides the arena (Ex: a MonotonicArena) and so decides how long it lives.  It must outlive every item (and copy)
+// naming a string in it.  Arenas only grow, so names are fixed at construction; make a new item to rename one, and release the
+// arena with the last of its items.  Items whose names all fit inline need no arena.  The price can be changed.
+//
+// Ordering, equality, and output are exactly those of GroceryItem, and the two convert into each other.
+class CompactGroceryItem
+{
+  friend std::ostream & operator<<( std::ostream & stream, CompactGroceryItem const & groceryItem );
+
+  public:
+    static constexpr std::size_t UPC_CAPACITY = 23;                           // longest UPC code held.  Longer ones are rejected
+
+    // Constructors.  Characters are copied, so the string parameters are only viewed, and names longer than Name::INLINE_CAPACITY
+    // into arena.  Throw std::length_error if the UPC code is longer than UPC_CAPACITY, or a name longer than 4 GiB, and
+    // std::invalid_argument if a name needs an arena and arena is null.
+    CompactGroceryItem() noexcept = default;
+    CompactGroceryItem( std::string_view productName,
+                        std::string_view brandName,
+                        std::string_view upcCode,
+                        Money            price,
+                        std::pmr::memory_resource * arena = nullptr );
+    CompactGroceryItem( std::string_view productName, std::string_view brandName, std::string_view upcCode, double price, std::pmr::memory_resource * arena = nullptr );
+    explicit CompactGroceryItem( GroceryItem const & groceryItem, std::pmr::memory_resource * arena = nullptr );
+
+    // Copy, move, assignment, and destruction are all implicit, and trivial
+
+    explicit operator GroceryItem() const;                                    // an equal GroceryItem, with its own copies of the strings
+
+    // Accessors
+    std::string_view upcCode    () const noexcept;
+    std::string_view brandName  () const noexcept;
+    std::string_view productName() const noexcept;
+    double           price      () const noexcept;                            // in dollars, exactly the double nearest the price in cents
+    Money            exactPrice () const noexcept;                            // in cents
+
+    // Modifiers
+    CompactGroceryItem & price( double newPrice ) & noexcept;                 // rounded to the nearest cent
+    CompactGroceryItem & price( Money  newPrice ) & noexcept;
+
+    // Relational Operators
+    std::weak_ordering operator<=>( CompactGroceryItem const & rhs ) const noexcept;
+    bool               operator== ( CompactGroceryItem const & rhs ) const noexcept;
+
+    // A string held inline when it fits in 15 characters, otherwise a view of characters in an arena.  Either way, 16 bytes.
+    class Name
+    {
+      public:
+        static constexpr std::size_t INLINE_CAPACITY = 15;
+
+        Name() noexcept = default;
+        Name( std::string_view text, std::pmr::memory_resource * arena );     // text is copied into arena only if it doesn't fit inline,
+                                                                              // and then arena mustn't be null
+
+        std::string_view view     () const noexcept;
+        bool             is_inline() const noexcept;
+
+      private:
+        static constexpr unsigned char ARENA = 0xFF;                          // tag of a name in an arena
+
+        // Inline, the characters followed by the length in the last byte.  In an arena, the address of the characters, their 32-bit
+        // length, and ARENA in the last byte.
+        alignas( 8 ) char _bytes[16] = {};
+    };
+
+  private:
+    char         _upcCode[UPC_CAPACITY] = {};
+    std::uint8_t _upcLength             = 0;
+    Name         _brandName;
+    Name         _productName;
+    Money        _price;
+};
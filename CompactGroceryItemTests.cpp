@@ -0,0 +1,141 @@
+#include <compare>                                                                          // weak_ordering
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <sstream>                                                                          // ostringstream
+#include <stdexcept>                                                                        // invalid_argument, length_error
+#include <string>
+#include <type_traits>                                                                      // is_trivially_copyable_v
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "CompactGroceryItem.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "MonotonicArena.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class CompactGroceryItemRegressionTest
+  {
+    public:
+      CompactGroceryItemRegressionTest();
+
+    private:
+      void construction();
+      void catalog();
+
+      Regression::CheckResults affirm;
+  } run_compactGroceryItem_tests;
+
+
+
+
+  void CompactGroceryItemRegressionTest::construction()
+  {
+    affirm.is_true( "Compact grocery item - trivially copyable          ", std::is_trivially_copyable_v<CompactGroceryItem> );
+    affirm.is_true( "Compact grocery item - smaller than GroceryItem    ", sizeof( CompactGroceryItem ) < sizeof( GroceryItem ) );
+
+    CompactGroceryItem const empty;
+    affirm.is_true( "Compact grocery item - default                     ", empty.upcCode().empty() && empty.brandName().empty() && empty.productName().empty() && empty.price() == 0.0 );
+
+    // Names right at, and just past, the inline capacity
+    MonotonicArena     arena;
+    std::string const  fits( CompactGroceryItem::Name::INLINE_CAPACITY, 'b' ), spills = fits + 'b';
+    CompactGroceryItem item( spills, fits, "00041520893307", 18.98, &arena );
+
+    affirm.is_equal( "Compact grocery item - inline name                ", fits,   std::string( item.brandName  () ) );
+    affirm.is_equal( "Compact grocery item - arena name                 ", spills, std::string( item.productName() ) );
+    affirm.is_equal( "Compact grocery item - UPC code                   ", std::string( "00041520893307" ), std::string( item.upcCode() ) );
+    affirm.is_equal( "Compact grocery item - price                      ", 18.98, item.price() );
+    affirm.is_equal( "Compact grocery item - only long names use arena  ", spills.size(), arena.bytes_allocated() );
+
+    // Copies share the arena's characters rather than copying them
+    auto copy = item;
+    affirm.is_true( "Compact grocery item - copy is equal               ", copy == item && copy.productName().data() == item.productName().data() );
+    copy.price( 1.99 );
+    affirm.is_true( "Compact grocery item - copies are independent      ", copy != item && item.price() == 18.98 );
+
+    // UPC codes up to the inline capacity, and no longer
+    std::string const longest( CompactGroceryItem::UPC_CAPACITY, '7' );
+    affirm.is_equal( "Compact grocery item - longest UPC code           ", longest, std::string( CompactGroceryItem( "", "", longest, 0.0 ).upcCode() ) );
+
+    bool thrown = false;
+    try                                   { CompactGroceryItem tooLong( "", "", longest + '7', 0.0 ); }
+    catch( std::length_error const & )    { thrown = true; }
+    affirm.is_true( "Compact grocery item - UPC code too long throws    ", thrown );
+
+    // Short names need no arena, and a long one won't be put anywhere the caller didn't choose
+    CompactGroceryItem const noArena( fits, fits, "00041520893307", 1.99 );
+    affirm.is_true( "Compact grocery item - inline names, no arena      ", noArena.productName() == fits && noArena.brandName() == fits );
+
+    bool needsArena = false;
+    try                                     { CompactGroceryItem longName( spills, fits, "00041520893307", 1.99 ); }
+    catch( std::invalid_argument const & )  { needsArena = true; }
+    affirm.is_true( "Compact grocery item - long name, no arena throws  ", needsArena );
+  }
+
+
+
+
+  void CompactGroceryItemRegressionTest::catalog()
+  {
+    // Every item in a catalog converts both ways unchanged, prints the same, and sorts into the same order
+    MappedFile               file( "Grocery_UPC_Database-Small.dat" );
+    std::vector<GroceryItem> items = parse_grocery_items( file.bytes() );
+    MonotonicArena           arena;
+
+    std::vector<CompactGroceryItem> compact;
+    for( auto const & item : items ) compact.emplace_back( item, &arena );
+
+    bool roundTrip = !items.empty(), sameOutput = true;
+    for( std::size_t i = 0; i < items.size(); ++i )
+    {
+      std::ostringstream expected, actual;
+      expected << items[i];
+      actual   << compact[i];
+      roundTrip  = roundTrip  && static_cast<GroceryItem>( compact[i] ) == items[i];
+      sameOutput = sameOutput && expected.str() == actual.str();
+    }
+    affirm.is_true( "Compact grocery item - catalog round trip          ", roundTrip  );
+    affirm.is_true( "Compact grocery item - same output as GroceryItem  ", sameOutput );
+
+    bool sameOrder = true;
+    for( std::size_t i = 0; i < items.size(); ++i )
+    {
+      for( std::size_t j = i; j < items.size() && j < i + 50; ++j )
+      {
+        sameOrder = sameOrder && ( compact[i] <=> compact[j] ) == ( items[i] <=> items[j] ) && ( compact[j] <=> compact[i] ) == ( items[j] <=> items[i] );
+      }
+    }
+    affirm.is_true( "Compact grocery item - same order as GroceryItem   ", sameOrder );
+  }
+
+
+
+
+  CompactGroceryItemRegressionTest::CompactGroceryItemRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nCompact GroceryItem Regression Test:\n";
+      construction();
+      catalog();
+
+      std::clog << "\n\nCompact GroceryItem Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class CompactGroceryItem\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,297 @@
+#include <algorithm>                                                          // max()
+#include <atomic>
+#include <chrono>                                                             // milliseconds
+#include <condition_variable>                                                 // condition_variable_any
+#include <cstddef>                                                            // size_t
+#include <exception>
+#include <filesystem>                                                         // last_write_time()
+#include <future>                                                             // promise, future
+#include <iostream>                                                           // cerr
+#include <memory>                                                             // unique_ptr, make_unique(), make_shared()
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>                                                          // runtime_error
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>                                                       // error_code
+#include <thread>                                                             // hardware_concurrency(), jthread
+#include <utility>                                                            // move()
+#include <vector>                                                             // erase_if()
+
+#include "ConcurrentGroceryItemDatabase.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemDatabase.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // How ReadCopyUpdate::update() copies a version:  a database copies itself with clone(), not a copy constructor
+  std::unique_ptr<GroceryItemDatabase> copy_of( GroceryItemDatabase const & database )
+  {
+    return database.clone();
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Construction
+*******************************************************************************/
+
+// instance()
+ConcurrentGroceryItemDatabase & ConcurrentGroceryItemDatabase::instance()
+{
+  static ConcurrentGroceryItemDatabase theInstance( GroceryItemDatabase::default_filename(), std::max( 1U, std::thread::hardware_concurrency() ) );
+  return theInstance;
+}
+
+
+
+
+// Construct from a database file
+ConcurrentGroceryItemDatabase::ConcurrentGroceryItemDatabase( std::string const & filename, std::size_t threads )
+  : _versions( std::make_unique<GroceryItemDatabase>( filename, threads ) )
+{}
+
+
+
+
+// Construct from a loaded database
+ConcurrentGroceryItemDatabase::ConcurrentGroceryItemDatabase( std::unique_ptr<GroceryItemDatabase> database )
+  : _versions( std::move( database ) )
+{}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Lookups
+*******************************************************************************/
+
+// snapshot()
+ConcurrentGroceryItemDatabase::Snapshot ConcurrentGroceryItemDatabase::snapshot() const noexcept
+{
+  return _versions.read();
+}
+
+
+
+
+// find()
+std::optional<GroceryItem> ConcurrentGroceryItemDatabase::find( std::string_view upc ) const
+{
+  auto current = _versions.read();
+  if( auto item = current->find( upc ) ) return *item;
+  return std::nullopt;
+}
+
+
+
+
+// price()
+std::optional<Money> ConcurrentGroceryItemDatabase::price( Upc upc ) const noexcept
+{
+  auto current = _versions.read();
+  if( auto item = current->find( upc ) ) return item->exactPrice();
+  return std::nullopt;
+}
+
+
+
+
+// size()
+std::size_t ConcurrentGroceryItemDatabase::size() const noexcept
+{
+  return _versions.read()->size();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Updates
+*******************************************************************************/
+
+// update_prices()
+std::size_t ConcurrentGroceryItemDatabase::update_prices( std::span<PriceChange const> changes )
+{
+  // Cloned, changed, published, and counted under the writer lock, so a concurrent update can't clone the same version and drop this
+  // one, and version() counts each version as it's published
+  return _versions.update( copy_of, [&]( GroceryItemDatabase & next )
+  {
+    std::size_t matched = 0;
+    for( auto const & change : changes )
+    {
+      if( auto item = next.find( change.upc ) )
+      {
+        item->price( change.price );
+        ++matched;
+      }
+    }
+    return matched;
+  }, [this] { count_version(); } );
+}
+
+
+
+
+// apply_delta()
+GroceryItemDatabase::DeltaCounts ConcurrentGroceryItemDatabase::apply_delta( std::string const & filename )
+{
+  // Serialized with price updates and other deltas the same way, so neither is lost to the other
+  return _versions.update( copy_of, [&]( GroceryItemDatabase & next ) { return next.apply_delta( filename ); }, [this] { count_version(); } );
+}
+
+
+
+
+// replace()
+void ConcurrentGroceryItemDatabase::replace( std::unique_ptr<GroceryItemDatabase> database )
+{
+  _versions.publish( std::move( database ), [this] { count_version(); } );
+}
+
+
+
+
+// count_version()
+void ConcurrentGroceryItemDatabase::count_version() noexcept
+{
+  _version.fetch_add( 1, std::memory_order_release );
+}
+
+
+
+
+// version()
+std::size_t ConcurrentGroceryItemDatabase::version() const noexcept
+{
+  return _version.load( std::memory_order_acquire );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Reloading
+*******************************************************************************/
+
+// reload()
+void ConcurrentGroceryItemDatabase::reload( std::string const & filename, std::size_t threads )
+{
+  // All the slow work, reading, parsing, and indexing, happens here before anything is published
+  auto next = std::make_unique<GroceryItemDatabase>( filename, threads );
+  if( next->size() == 0 ) throw std::runtime_error( "Grocery item database \"" + filename + "\" has no grocery items, keeping the current version" );
+
+  replace( std::move( next ) );
+}
+
+
+
+
+// reload_async()
+std::future<void> ConcurrentGroceryItemDatabase::reload_async( std::string filename, std::size_t threads )
+{
+  // Run on a thread this database owns and joins when destroyed, rather than by std::async, so the reload can't outlive the database
+  // even if the caller drops the future without waiting on it
+  std::promise<void> promise;
+  auto               future   = promise.get_future();
+  auto               finished = std::make_shared<std::atomic<bool>>( false );
+
+  std::scoped_lock lock( _reloadsMutex );
+  std::erase_if( _reloads, []( BackgroundReload const & reload ) { return reload.finished->load(); } );   // joins them, done already
+
+  std::jthread thread( [this, filename = std::move( filename ), threads, promise = std::move( promise ), finished]() mutable
+  {
+    try
+    {
+      reload( filename, threads );
+      promise.set_value();
+    }
+    catch( ... )
+    {
+      promise.set_exception( std::current_exception() );
+    }
+    *finished = true;
+  } );
+  _reloads.push_back( { std::move( thread ), std::move( finished ) } );
+
+  return future;
+}
+
+
+
+
+// watch()
+void ConcurrentGroceryItemDatabase::watch( std::string filename, std::chrono::milliseconds interval )
+{
+  stop_watching();
+
+  _watcher = std::jthread( [this, filename = std::move( filename ), interval]( std::stop_token stop )
+  {
+    std::error_code error;
+    auto            loaded  = std::filesystem::last_write_time( filename, error );   // the file as of the version being served
+    auto            pending = loaded;                                                 // the file as of the previous poll
+
+    std::mutex                  sleeping;
+    std::condition_variable_any wakeup;                                       // never notified, but a stop request interrupts the wait
+    std::unique_lock            lock( sleeping );
+
+    while( !wakeup.wait_for( lock, stop, interval, [&] { return stop.stop_requested(); } ) )
+    {
+      auto modified = std::filesystem::last_write_time( filename, error );
+      if( error ) continue;                                                   // Ex: the file is being replaced, try again next time
+
+      if( modified != pending ) { pending = modified;  continue; }            // changed since the last poll, may still be being written
+      if( modified == loaded  ) continue;                                     // unchanged since it was loaded
+
+      loaded = modified;                                                      // a failed load isn't retried until the file changes again
+      try
+      {
+        reload( filename );
+      }
+      catch( std::exception const & ex )
+      {
+        std::cerr << "Warning:  Could not reload grocery item database \"" << filename << "\":  " << ex.what() << '\n';
+      }
+    }
+  } );
+}
+
+
+
+
+// stop_watching()
+void ConcurrentGroceryItemDatabase::stop_watching() noexcept
+{
+  if( _watcher.joinable() )
+  {
+    _watcher.request_stop();
+    _watcher.join();
+  }
+}
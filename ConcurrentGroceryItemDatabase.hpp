@@ -0,0 +1,90 @@
+#pragma once                                                                  // include guard
+
+#include <atomic>
+#include <chrono>                                                             // milliseconds
+#include <cstddef>                                                            // size_t
+#include <future>
+#include <memory>                                                             // unique_ptr, shared_ptr
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>                                                             // jthread
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryItemDatabase.hpp"
+#include "Money.hpp"
+#include "ReadCopyUpdate.hpp"
+#include "Upc.hpp"
+
+
+
+
+// A grocery item database shared by many threads (Ex: every checkout lane in a store), safe for concurrent lookups and updates.
+//
+// The database is published in immutable versions.  Lookups are wait-free:  they pin the current version without locking and read
+// it while it is pinned.  An update copies the current version, changes the copy, and publishes it atomically, so a reader sees
+// either all of an update or none of it, never a version half updated.  Updates cost a full copy of the database, so they suit
+// occasional batches (Ex: a round of price changes), not a stream of single edits.
+//
+// The whole database can also be reloaded from its file while lookups carry on:  the file is loaded and indexed off to the side, on
+// the caller's thread, a background thread, or a watcher thread that notices the file changed, and then published like any update.
+class ConcurrentGroceryItemDatabase
+{
+  public:
+    using Snapshot = ReadCopyUpdate<GroceryItemDatabase>::ReadGuard;          // one pinned, read-only version of the database
+
+    struct PriceChange
+    {
+      Upc   upc;
+      Money price;
+    };
+
+    // The one and only shared instance, loaded from GroceryItemDatabase::default_filename()
+    static ConcurrentGroceryItemDatabase & instance();
+
+    // Constructors
+    explicit ConcurrentGroceryItemDatabase( std::string const & filename, std::size_t threads = 1 );   // load a database file, see GroceryItemDatabase
+    explicit ConcurrentGroceryItemDatabase( std::unique_ptr<GroceryItemDatabase> database );           // share an already loaded database
+
+    // Lookups, wait-free
+    Snapshot                   snapshot() const noexcept;                     // pin the current version.  Pointers found in it stay valid while it lives
+    std::optional<GroceryItem> find ( std::string_view upc ) const;           // a copy of the item, if found
+    std::optional<Money>       price( Upc upc )              const noexcept;  // the item's exact price, if found.  No allocation
+    std::size_t                size ()                       const noexcept;
+
+    // Updates, serialized with each other but never blocking lookups.  Must not be called by a thread holding a Snapshot.
+    std::size_t update_prices( std::span<PriceChange const> changes );        // apply every change in one new version, returns how many UPCs were found
+    void        replace      ( std::unique_ptr<GroceryItemDatabase> database );   // publish an entirely new database
+    GroceryItemDatabase::DeltaCounts apply_delta( std::string const & filename );   // apply a delta file (see GroceryItemDatabase::apply_delta())
+                                                                                    // in one new version.  Nothing is published if it throws
+
+    // Reloading, same rules as updates.  A file that yields no grocery items (Ex: missing, or corrupt) is not published, the current
+    // version is kept.
+    void              reload      ( std::string const & filename, std::size_t threads = 1 );    // load filename and publish it, throws std::runtime_error if not published
+    std::future<void> reload_async( std::string         filename, std::size_t threads = 1 );    // same, on a background thread.  The future carries any exception.
+                                                                                                // The future may be dropped:  destruction waits for the reload
+    void              watch       ( std::string filename, std::chrono::milliseconds interval = std::chrono::seconds( 1 ) );  // reload filename each time it changes, until stopped.
+    void              stop_watching() noexcept;                                                 // Replaces any previous watch.  A change is picked up once
+                                                                                                // the file has stayed unchanged for a whole interval, so a
+                                                                                                // file still being written isn't loaded half written
+
+    std::size_t version() const noexcept;                                     // how many versions have been published since construction
+
+  private:
+    void count_version() noexcept;                                            // called as each version is published, under the writer lock
+
+    ReadCopyUpdate<GroceryItemDatabase> _versions;
+    std::atomic<std::size_t>            _version = 0;
+
+    struct BackgroundReload                                                   // one reload_async() call's thread, and whether it has finished
+    {
+      std::jthread                       thread;
+      std::shared_ptr<std::atomic<bool>> finished;
+    };
+    std::mutex                          _reloadsMutex;
+    std::vector<BackgroundReload>       _reloads;                             // joined when destroyed, before the versions they reload
+    std::jthread                        _watcher;                             // declared last so it stops before the versions it reloads are destroyed
+};
@@ -0,0 +1,142 @@
+#include <algorithm>                                                                        // min()
+#include <atomic>
+#include <chrono>
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iostream>                                                                         // clog
+#include <mutex>                                                                            // shared_lock
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "ConcurrentGroceryItemDatabase.hpp"
+#include "GroceryItemDatabase.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class ConcurrentGroceryItemDatabaseBenchmark
+  {
+    public:
+      ConcurrentGroceryItemDatabaseBenchmark();
+
+    private:
+      void scaling( std::string const & filename );
+  } run_concurrentGroceryItemDatabase_benchmarks;
+
+
+
+
+  constexpr std::chrono::duration<double> DURATION = std::chrono::milliseconds( 250 );     // how long each measurement runs
+
+
+
+
+  struct Throughput
+  {
+    std::size_t lookups;
+    double      seconds;                                                      // from the first reader starting to the last one stopping
+  };
+
+
+
+
+  // Start threads readers, each calling lookup() with the UPCs in turn for about DURATION, and return the total number of lookups done.
+  // While the readers run, a writer calls write() every few milliseconds so the readers share the database with real updates.  The
+  // elapsed time is measured, not assumed, since a starved writer thread may stop the readers late.
+  template<typename Lookup, typename Write>
+  Throughput lookups_while_writing( std::size_t threads, std::vector<Upc> const & upcs, Lookup && lookup, Write && write )
+  {
+    std::atomic<bool>        done  = false;
+    std::atomic<std::size_t> total = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> readers;
+    for( std::size_t t = 0; t < threads; ++t )
+    {
+      readers.emplace_back( [&, t]
+      {
+        std::size_t count = 0;
+        for( std::size_t i = t * 7919; !done.load( std::memory_order_relaxed ); ++i, ++count ) Benchmark::do_not_optimize( lookup( upcs[i % upcs.size()] ) );
+        total += count;
+      } );
+    }
+
+    auto stop = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>( DURATION );
+    while( std::chrono::steady_clock::now() < stop )
+    {
+      write();
+      std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+    done = true;
+    for( auto & reader : readers ) reader.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return { total.load(), elapsed.count() };
+  }
+
+
+
+
+  // Reader throughput as the number of reader threads grows, while one writer publishes price changes.  The baseline guards a single
+  // database with a reader/writer lock, so every lookup writes the lock's shared counter and a writer stalls every reader; the
+  // read-copy-update database counts readers on separate cache lines and never makes them wait.
+  void ConcurrentGroceryItemDatabaseBenchmark::scaling( std::string const & filename )
+  {
+    MappedFile       file( filename );
+    std::vector<Upc> upcs;
+    for( auto const & item : parse_grocery_items( file.bytes() ) ) if( auto upc = Upc::parse( item.upcCode() ) ) upcs.push_back( *upc );
+    if( upcs.empty() ) return;
+
+    std::clog << "\n" << filename << ":  " << upcs.size() << " UPCs, " << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    std::vector<ConcurrentGroceryItemDatabase::PriceChange> changes;              // each write reprices a handful of items
+    for( std::size_t i = 0; i < std::min<std::size_t>( upcs.size(), 16 ); ++i ) changes.push_back( { upcs[i], Money( 1.0 ) } );
+
+    GroceryItemDatabase lockedDatabase( filename );
+    std::shared_mutex   lock;
+
+    ConcurrentGroceryItemDatabase concurrent( filename );
+
+    for( std::size_t threads : { 1, 2, 4, 8 } )
+    {
+      auto const suffix  = " - " + std::to_string( threads ) + ( threads == 1 ? " reader" : " readers" );
+
+      auto locked = lookups_while_writing( threads, upcs,
+        [&]( Upc upc ) { std::shared_lock guard( lock );  auto item = lockedDatabase.find( upc );  return item ? item->exactPrice() : Money(); },
+        [&]            { std::unique_lock guard( lock );  for( auto const & change : changes ) if( auto item = lockedDatabase.find( change.upc ) ) item->price( change.price ); } );
+      Benchmark::report( "price lookup, shared_mutex" + suffix, locked.lookups, locked.seconds );
+
+      auto rcu = lookups_while_writing( threads, upcs,
+        [&]( Upc upc ) { return concurrent.price( upc ).value_or( Money() ); },
+        [&]            { concurrent.update_prices( changes ); } );
+      Benchmark::report( "price lookup, read-copy-update" + suffix, rcu.lookups, rcu.seconds );
+    }
+  }
+
+
+
+
+  ConcurrentGroceryItemDatabaseBenchmark::ConcurrentGroceryItemDatabaseBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nConcurrent GroceryItem Database Benchmarks:  Reader throughput vs. threads, with a concurrent writer\n";
+      for( auto const & filename : Benchmark::database_files() ) scaling( filename );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"class ConcurrentGroceryItemDatabase\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
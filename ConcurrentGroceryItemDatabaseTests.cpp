@@ -0,0 +1,351 @@
+#include <algorithm>                                                                        // sort()
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>                                                                          // size_t
+#include <cstdint>                                                                          // int64_t
+#include <exception>
+#include <filesystem>                                                                       // temp_directory_path(), remove()
+#include <fstream>                                                                          // ofstream
+#include <future>                                                                           // future_status
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <memory>                                                                           // make_unique()
+#include <stdexcept>                                                                        // runtime_error
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "ConcurrentGroceryItemDatabase.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemDatabase.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
+
+
+
+
+
+namespace  // anonymous
+{
+  class ConcurrentGroceryItemDatabaseRegressionTest
+  {
+    public:
+      ConcurrentGroceryItemDatabaseRegressionTest();
+
+    private:
+      void tests();
+      void stress();
+      void reload();
+
+      Regression::CheckResults affirm;
+  } run_concurrentGroceryItemDatabase_tests;
+
+
+
+
+  void ConcurrentGroceryItemDatabaseRegressionTest::tests()
+  {
+    ConcurrentGroceryItemDatabase database( "Grocery_UPC_Database-Small.dat" );
+    GroceryItemDatabase           reference( "Grocery_UPC_Database-Small.dat" );
+
+    MappedFile file( "Grocery_UPC_Database-Small.dat" );
+    auto       items = parse_grocery_items( file.bytes() );
+
+    {  // Lookups agree with the single threaded database
+      bool identical = database.size() == reference.size();
+      for( auto const & item : items )
+      {
+        auto found = database.find( item.upcCode() );
+        identical  = identical && found && *found == *reference.find( item.upcCode() );
+      }
+      affirm.is_true ( "Concurrent - lookups match GroceryItemDatabase    ", identical );
+      affirm.is_true ( "Concurrent - find miss                            ", !database.find( "00000000000000" ).has_value() );
+      affirm.is_true ( "Concurrent - price miss                           ", !database.price( Upc( "99999999999999999" ) ).has_value() );
+    }
+
+    {  // A batch of price changes lands in one new version.  New readers see it at once, while a reader that pinned the previous version
+       // keeps reading it undisturbed, and the writer waits for that reader before the previous version is destroyed.
+      auto upc      = Upc::parse( items.front().upcCode() );
+      auto original = items.front().exactPrice();
+      auto pinned   = std::make_unique<ConcurrentGroceryItemDatabase::Snapshot>( database.snapshot() );
+
+      std::vector<ConcurrentGroceryItemDatabase::PriceChange> changes = { { *upc, original + Money( 1.0 ) }, { Upc( "99999999999999999" ), Money( 1.0 ) } };
+      std::atomic<std::size_t> found   = 0;
+      std::atomic<bool>        written = false;
+      std::thread              writer( [&] { found = database.update_prices( changes );  written = true; } );
+
+      while( database.price( *upc ) == original ) std::this_thread::yield();
+      affirm.is_equal( "Concurrent - price changed                        ", original + Money( 1.0 ), *database.price( *upc ) );
+      affirm.is_equal( "Concurrent - pinned snapshot unchanged            ", original, ( *pinned )->find( *upc )->exactPrice() );
+      affirm.is_true ( "Concurrent - writer waits for pinned readers      ", !written.load() );
+
+      pinned.reset();
+      writer.join();
+      affirm.is_equal( "Concurrent - price changes found                  ", std::size_t( 1 ), found.load() );
+    }
+
+    {  // Two writers racing each other, a batch per item between them:  every batch either one published is still there at the end,
+       // none overwritten by a version cloned before it was published
+      std::vector<Upc> upcs;
+      for( auto const & item : items ) if( auto upc = Upc::parse( item.upcCode() ) ) upcs.push_back( *upc );
+
+      std::atomic<bool> go = false;
+      auto writer = [&]( std::size_t first )
+      {
+        while( !go ) std::this_thread::yield();
+        for( std::size_t i = first; i < upcs.size(); i += 2 )
+        {
+          std::vector<ConcurrentGroceryItemDatabase::PriceChange> batch = { { upcs[i], Money::from_cents( 100'000 + static_cast<std::int64_t>( i ) ) } };
+          database.update_prices( batch );
+        }
+      };
+
+      auto const before = database.version();
+      {
+        std::jthread even( writer, 0 ), odd( writer, 1 );
+        go = true;
+      }
+
+      bool everyBatch = !upcs.empty();
+      for( std::size_t i = 0; i < upcs.size(); ++i ) everyBatch = everyBatch && database.price( upcs[i] ) == Money::from_cents( 100'000 + static_cast<std::int64_t>( i ) );
+      affirm.is_true ( "Concurrent - concurrent writers lose no batch     ", everyBatch );
+      affirm.is_equal( "Concurrent - one version per batch                ", before + upcs.size(), database.version() );
+    }
+
+    {  // Deltas applied while a writer publishes price batches:  every delta and every batch is there at the end
+      constexpr std::size_t DELTAS = 100;
+
+      std::vector<Upc> upcs;
+      for( auto const & item : items ) if( auto upc = Upc::parse( item.upcCode() ) ) upcs.push_back( *upc );
+
+      auto const path = ( std::filesystem::temp_directory_path() / "ConcurrentGroceryItemDatabaseTests.delta" ).string();
+      {
+        std::jthread deltas( [&]
+        {
+          for( std::size_t i = 0; i < DELTAS; ++i )
+          {
+            {
+              std::ofstream delta( path, std::ios::trunc );
+              delta << "\"DELTA-" << i << "\", \"Delta Brand\", \"Delta Product\", 1.25\n";
+            }
+            database.apply_delta( path );
+          }
+        } );
+
+        for( std::size_t i = 0; i < upcs.size(); ++i )
+        {
+          std::vector<ConcurrentGroceryItemDatabase::PriceChange> batch = { { upcs[i], Money::from_cents( 200'000 + static_cast<std::int64_t>( i ) ) } };
+          database.update_prices( batch );
+        }
+      }
+      std::filesystem::remove( path );
+
+      bool everyDelta = true, everyBatch = !upcs.empty();
+      for( std::size_t i = 0; i < DELTAS;      ++i ) everyDelta = everyDelta && database.find( "DELTA-" + std::to_string( i ) ).has_value();
+      for( std::size_t i = 0; i < upcs.size(); ++i ) everyBatch = everyBatch && database.price( upcs[i] ) == Money::from_cents( 200'000 + static_cast<std::int64_t>( i ) );
+      affirm.is_true( "Concurrent - deltas racing price updates kept     ", everyDelta );
+      affirm.is_true( "Concurrent - price updates racing deltas kept     ", everyBatch );
+    }
+
+    {  // Replacing the database publishes it whole
+      database.replace( std::make_unique<GroceryItemDatabase>( "Grocery_UPC_Database-Small.dat" ) );
+      affirm.is_equal( "Concurrent - replace                              ", items.front().exactPrice(), *database.price( *Upc::parse( items.front().upcCode() ) ) );
+    }
+
+    stress();
+    reload();
+  }
+
+
+
+
+  // Readers race a writer that publishes generation after generation.  Each generation gives every tracked item the same price, the
+  // generation number, so a reader that ever sees two prices within one snapshot saw a version half updated, and a reader that sees
+  // the generation go backwards saw versions out of order.
+  void ConcurrentGroceryItemDatabaseRegressionTest::stress()
+  {
+    constexpr std::size_t READERS     = 4;
+    constexpr std::size_t GENERATIONS = 200;
+
+    ConcurrentGroceryItemDatabase database( "Grocery_UPC_Database-Small.dat" );
+
+    MappedFile       file( "Grocery_UPC_Database-Small.dat" );
+    std::vector<Upc> tracked;
+    for( auto const & item : parse_grocery_items( file.bytes() ) ) if( auto upc = Upc::parse( item.upcCode() ) ) tracked.push_back( *upc );
+    if( tracked.size() > 64 ) tracked.erase( tracked.begin() + 64, tracked.end() );
+
+    auto generation = [&]( Money price )
+    {
+      std::vector<ConcurrentGroceryItemDatabase::PriceChange> changes;
+      for( auto upc : tracked ) changes.push_back( { upc, price } );
+      return changes;
+    };
+    database.update_prices( generation( Money() ) );
+
+    std::atomic<bool>        done = false;
+    std::atomic<std::size_t> torn = 0, reordered = 0, missing = 0, reads = 0;
+
+    std::vector<std::thread> readers;
+    for( std::size_t r = 0; r < READERS; ++r )
+    {
+      readers.emplace_back( [&]
+      {
+        Money       lastSeen;
+        std::size_t myReads  = 0;
+        do
+        {
+          auto   snapshot = database.snapshot();
+          auto * first    = snapshot->find( tracked.front() );
+          if( first == nullptr ) { ++missing; continue; }
+
+          Money price = first->exactPrice();
+          for( auto upc : tracked )
+          {
+            auto * item = snapshot->find( upc );
+            if     ( item == nullptr         ) ++missing;
+            else if( item->exactPrice() != price ) ++torn;
+          }
+          if( price < lastSeen ) ++reordered;
+          lastSeen = price;
+
+          ++myReads;
+        } while( !done.load() );
+        reads += myReads;
+      } );
+    }
+
+    for( std::size_t g = 1; g <= GENERATIONS; ++g ) database.update_prices( generation( Money::from_cents( static_cast<std::int64_t>( g ) ) ) );
+    done = true;
+    for( auto & reader : readers ) reader.join();
+
+    affirm.is_equal( "Concurrent stress - no torn snapshots             ", std::size_t( 0 ), torn.load()      );
+    affirm.is_equal( "Concurrent stress - generations never go back     ", std::size_t( 0 ), reordered.load() );
+    affirm.is_equal( "Concurrent stress - no item goes missing          ", std::size_t( 0 ), missing.load()   );
+    affirm.is_true ( "Concurrent stress - every reader read             ", reads.load() >= READERS );
+    affirm.is_equal( "Concurrent stress - last generation published     ", Money::from_cents( static_cast<std::int64_t>( GENERATIONS ) ), *database.price( tracked.back() ) );
+  }
+
+
+
+  // Reloading a changed file publishes it, whether asked for or noticed by the watcher, and a bad file never replaces a good
+  // version.  While a reload is running, lookups carry on at their usual speed:  the slow part, loading and indexing, never blocks them.
+  void ConcurrentGroceryItemDatabaseRegressionTest::reload()
+  {
+    using namespace std::chrono_literals;
+
+    MappedFile original( "Grocery_UPC_Database-Small.dat" );
+    auto       items = parse_grocery_items( original.bytes() );
+    auto       upc   = *Upc::parse( items.front().upcCode() );
+
+    auto const path  = ( std::filesystem::temp_directory_path() / "ConcurrentGroceryItemDatabaseTests.dat" ).string();
+    auto       write = [&]( double firstPrice )
+    {
+      items.front().price( firstPrice );
+      std::ofstream file( path, std::ios::trunc );
+      for( auto const & item : items ) file << item << '\n';
+    };
+
+    write( 1.25 );
+    ConcurrentGroceryItemDatabase database( path );
+
+    {  // Reload on request, now or in the background
+      write( 2.50 );
+      database.reload( path );
+      affirm.is_equal( "Concurrent reload - price reloaded                ", Money( 2.50 ), *database.price( upc ) );
+
+      write( 3.75 );
+      database.reload_async( path ).get();
+      affirm.is_equal( "Concurrent reload - price reloaded in background  ", Money( 3.75 ), *database.price( upc ) );
+
+      bool thrown = false;
+      try                                     { database.reload( path + ".missing" ); }
+      catch( std::runtime_error const & )     { thrown = true;                         }
+      affirm.is_true ( "Concurrent reload - missing file rejected         ", thrown && database.size() == items.size() );
+    }
+
+    {  // A background reload the caller hasn't waited on is finished by the time its database is destroyed
+      std::future<void> pending;
+      {
+        ConcurrentGroceryItemDatabase scratch( path );
+        pending = scratch.reload_async( path );
+      }
+      affirm.is_true ( "Concurrent reload - destruction waits for reload  ", pending.wait_for( 0s ) == std::future_status::ready );
+    }
+
+    {  // The watcher reloads the file once it has changed and settled
+      database.watch( path, 10ms );
+      auto before = database.version();
+
+      std::this_thread::sleep_for( 20ms );
+      write( 5.00 );
+
+      auto deadline = std::chrono::steady_clock::now() + 5s;
+      while( database.version() == before && std::chrono::steady_clock::now() < deadline ) std::this_thread::sleep_for( 5ms );
+      database.stop_watching();
+      affirm.is_equal( "Concurrent reload - watcher reloaded changed file ", Money( 5.00 ), database.price( upc ).value_or( Money() ) );
+    }
+
+    {  // Lookup latency while reloading, against lookups with no reload running
+      auto percentiles = [&]( bool reloading )
+      {
+        std::atomic<bool>  done = false;
+        std::thread        reloader( [&] { while( reloading && !done ) database.reload( path ); } );
+
+        std::vector<double> nanoseconds;
+        nanoseconds.reserve( 200'000 );
+        for( std::size_t i = 0; i < nanoseconds.capacity(); ++i )
+        {
+          auto start = std::chrono::steady_clock::now();
+          auto price = database.price( upc );
+          std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+          nanoseconds.push_back( price ? elapsed.count() : 1e12 );            // a miss, were one possible, fails the test
+        }
+        done = true;
+        reloader.join();
+
+        std::sort( nanoseconds.begin(), nanoseconds.end() );
+        return std::array<double, 3>{ nanoseconds[nanoseconds.size() / 2], nanoseconds[nanoseconds.size() * 99 / 100], nanoseconds[nanoseconds.size() * 999 / 1000] };
+      };
+
+      auto quiet     = percentiles( false );
+      auto reloading = percentiles( true  );
+
+      std::clog << "  Lookup latency (ns)            p50        p99      p99.9\n"
+                << "    without reload      " << std::setw( 11 ) << quiet    [0] << std::setw( 11 ) << quiet    [1] << std::setw( 11 ) << quiet    [2] << '\n'
+                << "    during reload       " << std::setw( 11 ) << reloading[0] << std::setw( 11 ) << reloading[1] << std::setw( 11 ) << reloading[2] << '\n';
+
+      // Generous bounds relative to the quiet run, so a slow or loaded machine (or a sanitizer build) slows both runs alike, and the
+      // tail, noisier still, gets more room.  A lookup blocked behind a reload would take as long as the reload itself, milliseconds.
+      // The absolute numbers are for the report above, not for passing or failing.
+      affirm.is_true ( "Concurrent reload - p50 latency unaffected        ", reloading[0] < quiet[0] *  4 + 1'000 );
+      affirm.is_true ( "Concurrent reload - p99 latency unaffected        ", reloading[1] < quiet[1] * 10 + 1'000 );
+    }
+
+    std::filesystem::remove( path );
+  }
+
+
+
+  ConcurrentGroceryItemDatabaseRegressionTest::ConcurrentGroceryItemDatabaseRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nConcurrent GroceryItem Database Regression Test:\n";
+      tests();
+
+      std::clog << "\n\nConcurrent GroceryItem Database Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class ConcurrentGroceryItemDatabase\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
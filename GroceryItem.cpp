@@ -1,49 +1,33 @@
-#include <algorithm>                                                  // max()
-#include <cmath>                                                      // abs(), pow()
+#include <algorithm>                                                  // copy_n(), min()
 #include <compare>                                                    // weak_ordering
+#include <cstddef>                                                    // size_t
 #include <iomanip>                                                    // quoted(), ios::failbit
 #include <iostream>                                                   // istream, ostream, ws()
+#include <memory_resource>                                            // pmr::string
 #include <string>
-#include <type_traits>                                                // is_floating_point_v, common_type_t
+#include <string_view>
 #include <utility>                                                    // move()
 
 #include "GroceryItem.hpp"
+#include "Money.hpp"
 
 
 
 /*******************************************************************************
-**  Implementation of non-member private types, objects, and functions
+**  Constructors, assignments, and destructor
 *******************************************************************************/
-namespace    // unnamed, anonymous namespace
-{
-  // Avoid direct equality comparisons on floating point numbers. Two values are equal if they are "close enough", which is
-  // represented by Epsilon.  Usually, this is a pretty small number, but since we are dealing with money (only two, maybe three
-  // decimal places) we need to be a bit more tolerant.
-  //
-  // The two values are "close enough" to be considered equal if the distance between lhs and rhs is less than:
-  // o)  EPSILON1, otherwise
-  // o)  EPSILON2 percentage of the larger value's magnitude
-
-  template< typename T,  typename U >   requires std::is_floating_point_v<std::common_type_t<T, U> >
-  constexpr bool floating_point_is_equal( T const lhs,  U const rhs,  long double const EPSILON1 = /*1e-12L*/ 1e-4L,  long double const EPSILON2 = 1e-8L ) noexcept
-  {
-    return std::abs(lhs - rhs) < EPSILON1 || std::abs(lhs - rhs) < EPSILON2 * std::max(std::abs(lhs), std::abs(rhs));
-  }
-}    // unnamed, anonymous namespace
-
-
-
 
+// Default and Conversion Constructor
+GroceryItem::GroceryItem( std::string_view productName, std::string_view brandName, std::string_view upcCode, double price, allocator_type allocator )
+  : GroceryItem(productName, brandName, upcCode, Money(price), allocator)
+{}
 
 
 
-/*******************************************************************************
-**  Constructors, assignments, and destructor
-*******************************************************************************/
 
-// Default and Conversion Constructor
-GroceryItem::GroceryItem( std::string productName, std::string brandName, std::string upcCode, double price )
-  : _productName(std::move(productName)), _brandName(std::move(brandName)), _upcCode(std::move(upcCode)), _price(price)
+// Constructor from a price in cents
+GroceryItem::GroceryItem( std::string_view productName, std::string_view brandName, std::string_view upcCode, Money price, allocator_type allocator )
+  : _upcCode(upcCode, allocator), _brandName(brandName, allocator), _productName(productName, allocator), _price(price), _sortKey(sort_key(upcCode))
 {}                                                                    // Avoid setting values in constructor's body (when possible)
 
 
@@ -51,7 +35,7 @@ GroceryItem::GroceryItem( std::string productName, std::string brandName, std::s
 
 // Copy constructor
 GroceryItem::GroceryItem( GroceryItem const & other )
-  : _productName(other._productName), _brandName(other._brandName), _upcCode(other._upcCode), _price(other._price)
+  : _upcCode(other._upcCode), _brandName(other._brandName), _productName(other._productName), _price(other._price), _sortKey(other._sortKey)
 {}                                                                    // Avoid setting values in constructor's body (when possible)
 
 
@@ -59,12 +43,32 @@ GroceryItem::GroceryItem( GroceryItem const & other )
 
 // Move constructor
 GroceryItem::GroceryItem( GroceryItem && other ) noexcept
-  : _productName(std::move(other._productName)), _brandName(std::move(other._brandName)), _upcCode(std::move(other._upcCode)), _price(other._price)
+  : _upcCode(std::move(other._upcCode)), _brandName(std::move(other._brandName)), _productName(std::move(other._productName)), _price(other._price), _sortKey(other._sortKey)
+{
+  other._sortKey = sort_key(other._upcCode);                          // whatever the moved-from string now holds
+}
+
+
+
+
+// Allocator-extended copy constructor
+GroceryItem::GroceryItem( GroceryItem const & other, allocator_type allocator )
+  : _upcCode(other._upcCode, allocator), _brandName(other._brandName, allocator), _productName(other._productName, allocator), _price(other._price), _sortKey(other._sortKey)
 {}
 
 
 
 
+// Allocator-extended move constructor  (moves if other uses the same memory resource, copies otherwise)
+GroceryItem::GroceryItem( GroceryItem && other, allocator_type allocator )
+  : _upcCode(std::move(other._upcCode), allocator), _brandName(std::move(other._brandName), allocator), _productName(std::move(other._productName), allocator), _price(other._price), _sortKey(other._sortKey)
+{
+  other._sortKey = sort_key(other._upcCode);                          // whatever the moved-from string now holds (unchanged if copied)
+}
+
+
+
+
 // Copy Assignment Operator
 GroceryItem & GroceryItem::operator=( GroceryItem const & rhs ) &
 {
@@ -73,6 +77,7 @@ GroceryItem & GroceryItem::operator=( GroceryItem const & rhs ) &
     _brandName = rhs._brandName;
     _upcCode = rhs._upcCode;
     _price = rhs._price;
+    _sortKey = rhs._sortKey;
   }
   return *this;
 }
@@ -88,6 +93,8 @@ GroceryItem & GroceryItem::operator=( GroceryItem && rhs ) & noexcept
     _brandName = std::move(rhs._brandName);
     _upcCode = std::move(rhs._upcCode);
     _price = rhs._price;
+    _sortKey = rhs._sortKey;
+    rhs._sortKey = sort_key(rhs._upcCode);                            // whatever the moved-from string now holds
   }
   return *this;
 }
@@ -100,6 +107,15 @@ GroceryItem::~GroceryItem() noexcept = default;
 
 
 
+// get_allocator()
+GroceryItem::allocator_type GroceryItem::get_allocator() const noexcept
+{
+  return _upcCode.get_allocator();
+}
+
+
+
+
 
 
 
@@ -109,7 +125,7 @@ GroceryItem::~GroceryItem() noexcept = default;
 *******************************************************************************/
 
 // upcCode() const    (L-value objects)
-std::string const & GroceryItem::upcCode() const &
+std::string_view GroceryItem::upcCode() const &
 {
   return _upcCode;
 }
@@ -118,7 +134,7 @@ std::string const & GroceryItem::upcCode() const &
 
 
 // brandName() const    (L-value objects)
-std::string const & GroceryItem::brandName() const &
+std::string_view GroceryItem::brandName() const &
 {
   return _brandName;
 }
@@ -127,7 +143,7 @@ std::string const & GroceryItem::brandName() const &
 
 
 // productName() const    (L-value objects)
-std::string const & GroceryItem::productName() const &
+std::string_view GroceryItem::productName() const &
 {
   return _productName;
 }
@@ -136,6 +152,15 @@ std::string const & GroceryItem::productName() const &
 
 // price() const    (L-value and, because there is no R-value overload, R-value objects)
 double GroceryItem::price() const &
+{
+  return _price.dollars();
+}
+
+
+
+
+// exactPrice() const    (L-value and, because there is no R-value overload, R-value objects)
+Money GroceryItem::exactPrice() const &
 {
   return _price;
 }
@@ -146,7 +171,12 @@ double GroceryItem::price() const &
 // upcCode()    (R-value objects)
 std::string GroceryItem::upcCode() &&
 {
-  return std::move(_upcCode);
+  // The characters are copied out, since std::string can't take over an allocator-aware buffer, and the source is left empty just as
+  // a move would leave it
+  std::string upcCode( _upcCode );
+  _upcCode.clear();
+  _sortKey = sort_key(_upcCode);
+  return upcCode;
 }
 
 
@@ -155,7 +185,9 @@ std::string GroceryItem::upcCode() &&
 // brandName()    (R-value objects)
 std::string GroceryItem::brandName() &&
 {
-  return std::move(_brandName);
+  std::string brandName( _brandName );
+  _brandName.clear();
+  return brandName;
 }
 
 
@@ -164,7 +196,9 @@ std::string GroceryItem::brandName() &&
 // productName()    (R-value objects)
 std::string GroceryItem::productName() &&
 {
-  return std::move(_productName);
+  std::string productName( _productName );
+  _productName.clear();
+  return productName;
 }
 
 
@@ -179,9 +213,10 @@ std::string GroceryItem::productName() &&
 *******************************************************************************/
 
 // upcCode(...)
-GroceryItem & GroceryItem::upcCode( std::string newUpcCode ) &
+GroceryItem & GroceryItem::upcCode( std::string_view newUpcCode ) &
 {
-  _upcCode = std::move(newUpcCode);
+  _upcCode = newUpcCode;
+  _sortKey = sort_key(_upcCode);
   return *this;
 }
 
@@ -189,9 +224,9 @@ GroceryItem & GroceryItem::upcCode( std::string newUpcCode ) &
 
 
 // brandName(...)
-GroceryItem & GroceryItem::brandName( std::string newBrandName ) &
+GroceryItem & GroceryItem::brandName( std::string_view newBrandName ) &
 {
-  _brandName = std::move(newBrandName);
+  _brandName = newBrandName;
   return *this;
 }
 
@@ -199,9 +234,9 @@ GroceryItem & GroceryItem::brandName( std::string newBrandName ) &
 
 
 // productName(...)
-GroceryItem & GroceryItem::productName( std::string newProductName ) &
+GroceryItem & GroceryItem::productName( std::string_view newProductName ) &
 {
-  _productName = std::move(newProductName);
+  _productName = newProductName;
   return *this;
 }
 
@@ -210,6 +245,16 @@ GroceryItem & GroceryItem::productName( std::string newProductName ) &
 
 // price(...)
 GroceryItem & GroceryItem::price( double newPrice ) &
+{
+  _price = Money(newPrice);
+  return *this;
+}
+
+
+
+
+// price(...)
+GroceryItem & GroceryItem::price( Money newPrice ) &
 {
   _price = newPrice;
   return *this;
@@ -222,6 +267,34 @@ GroceryItem & GroceryItem::price( double newPrice ) &
 
 
 
+/*******************************************************************************
+**  Sort Keys
+*******************************************************************************/
+
+// sort_key()
+GroceryItem::SortKey GroceryItem::sort_key( std::string_view upcCode ) noexcept
+{
+  // Short codes are padded with zero bytes, which sort before every other byte just as a shorter string sorts before a longer one
+  // it prefixes.  The one ambiguity, a code that itself continues with zero bytes, is left to the string comparison.
+  unsigned char bytes[16] = {};
+  std::copy_n(upcCode.data(), std::min<std::size_t>(upcCode.size(), sizeof(bytes)), bytes);
+
+  SortKey key;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    key.high = key.high << 8 | bytes[i    ];
+    key.low  = key.low  << 8 | bytes[i + 8];
+  }
+  return key;
+}
+
+
+
+
+
+
+
+
 /*******************************************************************************
 **  Relational Operators
 *******************************************************************************/
@@ -233,18 +306,17 @@ std::weak_ordering GroceryItem::operator<=>( const GroceryItem & rhs ) const noe
   //                         auto operator<=>( const GroceryItem & ) const = default;
   //                   in the class definition (header file) would get very close to what is needed and would allow both the <=> and
   //                   the == operators defined here to be skipped.  The physical ordering of the attributes in the class definition
-  //                   would have to be changed (easy enough in this case) but the default directly compares floating point types
-  //                   (price) for equality, and that should be avoided, in general. For example, if x and y are of type double,
-  //                   then  x < y  is okay but  x == y  is not.  So these (operator<=> and operator==) explicit definitions are
-  //                   provided.
+  //                   would have to be changed (easy enough in this case).  The price is held in whole cents (class Money), so it
+  //                   compares exactly with plain integer comparisons, no epsilon needed.  Explicit definitions are still provided
+  //                   to keep the ordering of the attributes independent of their physical order in the class.
   //
   //                   Also, many ordering (sorting) algorithms, like those used in std::map and std::set, require at least a weak
-  //                   ordering of elements. operator<=> provides only a partial ordering when comparing floating point numbers.
+  //                   ordering of elements.  Strings and Money are strongly ordered, which is stronger still.
   //
-  // Weak order:       Objects that compare equal but are not substitutable (identical).  For example, since _price can be within
-  //                   EPSILON, GroceryItem("ProductName", "BrandName", "UPC", 9.99999) and GroceryItem("ProductName", "BrandName",
-  //                   "UPC", 10.00001) are equal but they are not identical.  If you ignore case when comparing strings, as another
-  //                   example, GroceryItem("ProductName") and GroceryItem("productName") are equal but they are not identical.
+  // Weak order:       Objects that compare equal but are not substitutable (identical).  For example, if you ignore case when
+  //                   comparing strings, GroceryItem("ProductName") and GroceryItem("productName") are equal but they are not
+  //                   identical.  Prices given in dollars are rounded to the nearest cent first, so GroceryItem("ProductName",
+  //                   "BrandName", "UPC", 9.99999) and GroceryItem("ProductName", "BrandName", "UPC", 10.00001) are identical.
   //
   // See std::weak_ordering    at https://en.cppreference.com/w/cpp/utility/compare/weak_ordering and
   //     std::partial_ordering at https://en.cppreference.com/w/cpp/utility/compare/partial_ordering
@@ -252,8 +324,13 @@ std::weak_ordering GroceryItem::operator<=>( const GroceryItem & rhs ) const noe
   //     Spaceship (Three way comparison) Operator Demystified https://youtu.be/S9ShnAFmiWM
   //
   //
-  // Grocery items are equal if all attributes are equal (or within Epsilon for floating point numbers, like price). Grocery items are ordered
+  // Grocery items are equal if all attributes are equal, to the cent for price.  Grocery items are ordered
   // (sorted) by UPC code, product name, brand name, then price.
+  //
+  // The sort keys order the first 16 bytes of the UPC codes exactly as the strings would, so if they differ they decide the UPC
+  // comparison, and so the whole comparison, with two integer compares.
+
+  if (auto cmp = _sortKey <=> rhs._sortKey; cmp != 0) return cmp;
 
   auto cmp = _upcCode <=> rhs._upcCode;
   if (cmp != 0) return cmp;
@@ -261,7 +338,7 @@ std::weak_ordering GroceryItem::operator<=>( const GroceryItem & rhs ) const noe
   if (cmp != 0) return cmp;
   cmp = _brandName <=> rhs._brandName;
   if (cmp != 0) return cmp;
-  return floating_point_is_equal(_price, rhs._price) ? std::weak_ordering::equivalent : (_price < rhs._price ? std::weak_ordering::less : std::weak_ordering::greater);
+  return _price <=> rhs._price;
 }
 
 
@@ -273,7 +350,7 @@ bool GroceryItem::operator==( const GroceryItem & rhs ) const noexcept
   // All attributes must be equal for the two grocery items to be equal to the other.  This can be done in any order, so put the
   // quickest and then the most likely to be different first.
 
-  return _upcCode == rhs._upcCode && _productName == rhs._productName && _brandName == rhs._brandName && floating_point_is_equal(_price, rhs._price);
+  return _sortKey == rhs._sortKey && _upcCode == rhs._upcCode && _productName == rhs._productName && _brandName == rhs._brandName && _price == rhs._price;
 }
 
 
@@ -298,9 +375,9 @@ std::istream & operator>>( std::istream & stream, GroceryItem & groceryItem )
 
   char delimiter = '\x{0000}';  // C++23 delimited escape sequence for the character whose value is zero, i.e., the null character
   std::string upcCode, brandName, productName;
-  double price;
+  Money price;
   if (stream >> std::quoted(upcCode) >> delimiter >> std::quoted(brandName) >> delimiter >> std::quoted(productName) >> delimiter >> price) {
-    groceryItem = GroceryItem(std::move(productName), std::move(brandName), std::move(upcCode), price);
+    groceryItem = GroceryItem(productName, brandName, upcCode, price, groceryItem.get_allocator());   // same resource, so the move assignment below doesn't copy
   } else {
     stream.setstate(std::ios::failbit);
   }
@@ -1,9 +1,14 @@
 #pragma once                                                                  // include guard
 
 #include <compare>                                                            // std::weak_ordering
+#include <cstddef>                                                            // byte
+#include <cstdint>                                                            // uint64_t
 #include <iostream>
+#include <memory_resource>                                                    // polymorphic_allocator
 #include <string>
+#include <string_view>
 
+#include "Money.hpp"
 
 
 
@@ -14,11 +19,19 @@ class GroceryItem
   friend std::istream & operator>>( std::istream & stream, GroceryItem       & groceryItem );
 
   public:
+    // Allocator awareness.  A grocery item's strings come from its allocator's memory resource, the default (new and delete) unless one
+    // is given.  Containers like std::pmr::vector<GroceryItem> pass their allocator along, and a bulk loader can place every item in
+    // an arena so no field costs a heap allocation of its own.  Copies use the default resource unless given an allocator; moves keep
+    // the source's.  Memory from a resource must outlive every item using it.
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
     // Constructors, assignments, and destructor
-    GroceryItem( std::string productName = {},                                // Default and Conversion (from string to GroceryItem) constructor
-                 std::string brandName   = {},                                // String parameters intentionally passed by value.  Not perfect, but very very
-                 std::string upcCode     = {},                                // good when combined with move semantics.  See https://youtu.be/PNRju6_yn3o
-                 double      price       = 0.0 );
+    GroceryItem( std::string_view productName = {},                           // Default and Conversion (from string to GroceryItem) constructor
+                 std::string_view brandName   = {},                           // The characters are copied into storage from allocator, so string parameters are
+                 std::string_view upcCode     = {},                           // viewed, not owned.  Accepts std::string, std::pmr::string, string literals, and
+                 double           price       = 0.0,                          // views into a buffer (Ex: a memory mapped file) alike.  Price is in dollars,
+                 allocator_type   allocator   = {} );                         // rounded to the nearest cent
+    GroceryItem( std::string_view productName, std::string_view brandName, std::string_view upcCode, Money price, allocator_type allocator = {} );
 
     GroceryItem & operator=( GroceryItem const  & rhs   ) &;                  // Assignment operators available only for l-values (that's what the trailing "&" means), and then
     GroceryItem & operator=( GroceryItem       && rhs   ) & noexcept;         // the 'Rule of 5' says if you define one, then you should define them all
@@ -26,23 +39,29 @@ class GroceryItem
     GroceryItem            ( GroceryItem       && other )   noexcept;         // Error:  GroceryItem{} = a;              (GroceryItem{} is an r-value, i.e., an unnamed temporary object)
    ~GroceryItem            (                            )   noexcept;
 
+    GroceryItem            ( GroceryItem const  & other, allocator_type allocator );   // Allocator-extended copy and move constructors, used by
+    GroceryItem            ( GroceryItem       && other, allocator_type allocator );   // allocator-aware containers
+
+    allocator_type get_allocator() const noexcept;
+
 
     // Accessors
-    std::string const & upcCode    () const &;                                // Returns object's state by constant reference for l-value objects and by value for r-value objects
-    std::string const & brandName  () const &;                                // The "const &" at the end says these functions will be called for l-value objects and r-value objects
-    std::string const & productName() const &;                                // that (listen carefully) haven't been overloaded.
-    double              price      () const &;                                //
-                                                                              //
-    std::string         upcCode    ()       &&;                               // Overloads that return an r-value object's state by value (unsafe to return an r-value's state by reference)
-    std::string         brandName  ()       &&;                               // The "&&" at the end says these functions will be called only for r-value objects
-    std::string         productName()       &&;                               // Search "lvalue vs rvalue", or see https://www.learncpp.com/cpp-tutorial/value-categories-lvalues-and-rvalues/,
+    std::string_view upcCode    () const &;                                   // Returns object's state by view for l-value objects and by value for r-value objects.  Views
+    std::string_view brandName  () const &;                                   // stay valid until the item is modified or destroyed.  The "const &" at the end says these functions
+    std::string_view productName() const &;                                   // will be called for l-value objects and r-value objects that (listen carefully) haven't been overloaded.
+    double           price      () const &;                                   // in dollars, exactly the double nearest the price in cents
+    Money            exactPrice () const &;                                   // in cents, for exact totals and comparisons
+    std::string      upcCode    ()       &&;                                  // Overloads that return an r-value object's state by value (unsafe to return an r-value's state by reference)
+    std::string      brandName  ()       &&;                                  // The "&&" at the end says these functions will be called only for r-value objects
+    std::string      productName()       &&;                                  // Search "lvalue vs rvalue", or see https://www.learncpp.com/cpp-tutorial/value-categories-lvalues-and-rvalues/,
                                                                               // https://www.bing.com/videos/search?q=chono+c%2b%2b+lvalue+vs+rvalue&docid=608038928535204227&mid=6E0B93922619A11969BB6E0B93922619A11969BB&view=detail&FORM=VIRE
 
     // Modifiers                                                              // Updates object's state and returns a reference to self (enables chaining)
-    GroceryItem & upcCode    ( std::string newUpcCode     ) &;                // String parameters intentionally passed by value
-    GroceryItem & brandName  ( std::string newBrandName   ) &;                // Modifiers available for l-values only         (The & at the end says these functions will be called only for l-values)
-    GroceryItem & productName( std::string newProductName ) &;                // OK:     GroceryItem b; b.price(13.99);        (b is an l-value, i.e. a named object)
-    GroceryItem & price      ( double      newPrice       ) &;                // Error:  GroceryItem{}.price(13.99);           (The default constructed GrocerItem is an r-value, i.e., an unnamed temporary object)
+    GroceryItem & upcCode    ( std::string_view newUpcCode     ) &;           // Characters are copied into storage from the item's own allocator
+    GroceryItem & brandName  ( std::string_view newBrandName   ) &;           // Modifiers available for l-values only         (The & at the end says these functions will be called only for l-values)
+    GroceryItem & productName( std::string_view newProductName ) &;           // OK:     GroceryItem b; b.price(13.99);        (b is an l-value, i.e. a named object)
+    GroceryItem & price      ( double           newPrice       ) &;           // Error:  GroceryItem{}.price(13.99);           (The default constructed GrocerItem is an r-value, i.e., an unnamed temporary object)
+    GroceryItem & price      ( Money            newPrice       ) &;           // Prices in dollars are rounded to the nearest cent
 
 
     // Relational Operators
@@ -50,8 +69,24 @@ class GroceryItem
     bool               operator== ( GroceryItem const & rhs ) const noexcept;
 
   private:
-    std::string _upcCode;                                                     // a 12 or 14-digit international Universal Product Code uniquely identifying this item (Ex: 051600080015, 05017402006207)
-    std::string _brandName;                                                   // the product manufacturer's brand name (Ex: Heinz, Boston Market)
-    std::string _productName;                                                 // the name of the product (Ex: Heinz Tomato Ketchup - 2 Ct, Boston Market Spaghetti With Meatballs)
-    double      _price{ 0.0 };                                                // the cost of the item in US Dollars (Ex:  2.29, 1.19)
+    std::pmr::string _upcCode;                                                // a 12 or 14-digit international Universal Product Code uniquely identifying this item (Ex: 051600080015, 05017402006207)
+    std::pmr::string _brandName;                                              // the product manufacturer's brand name (Ex: Heinz, Boston Market)
+    std::pmr::string _productName;                                            // the name of the product (Ex: Heinz Tomato Ketchup - 2 Ct, Boston Market Spaghetti With Meatballs)
+    Money            _price;                                                  // the cost of the item in US Dollars, held in whole cents (Ex:  2.29, 1.19)
+
+    // The first 16 bytes of the UPC code packed big-endian into two integers, so comparing keys compares those bytes in the same
+    // (unsigned, lexicographic) order std::string does.  UPC codes are 11 to 14 characters, so nearly every comparison is decided
+    // by the keys alone, and only UPC codes that agree in their first 16 bytes (Ex: the same UPC) go on to compare strings.  Kept in
+    // step with _upcCode by every constructor, assignment, and modifier.
+    struct SortKey
+    {
+      std::uint64_t high = 0;
+      std::uint64_t low  = 0;
+
+      constexpr auto operator<=>( SortKey const & ) const noexcept = default;
+    };
+
+    static SortKey sort_key( std::string_view upcCode ) noexcept;
+
+    SortKey          _sortKey;
 };
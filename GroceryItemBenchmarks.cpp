@@ -0,0 +1,159 @@
+#include <algorithm>                                                                        // sort(), shuffle(), max()
+#include <compare>                                                                          // weak_ordering
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iostream>                                                                         // clog
+#include <random>                                                                           // mt19937_64
+#include <stack>
+#include <string>
+#include <type_traits>                                                                      // decay_t
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "CompactGroceryItem.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "MonotonicArena.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemBenchmark
+  {
+    public:
+      GroceryItemBenchmark();
+
+    private:
+      void sort( std::string const & filename );
+      void copy( std::string const & filename );
+  } run_groceryItem_benchmarks;
+
+
+
+
+  // The comparison GroceryItem::operator<=>() made before the sort keys:  UPC code, product name, and brand name compared as whole
+  // strings, then price
+  std::weak_ordering string_compare( GroceryItem const & lhs, GroceryItem const & rhs )
+  {
+    if( auto cmp = lhs.upcCode    () <=> rhs.upcCode    (); cmp != 0 ) return cmp;
+    if( auto cmp = lhs.productName() <=> rhs.productName(); cmp != 0 ) return cmp;
+    if( auto cmp = lhs.brandName  () <=> rhs.brandName  (); cmp != 0 ) return cmp;
+    return lhs.exactPrice() <=> rhs.exactPrice();
+  }
+
+
+
+
+  // Sorting the whole catalog, shuffled, with and without the cached sort keys.  Pointers are sorted so the measurements are of the
+  // comparisons, not of moving grocery items around.
+  void GroceryItemBenchmark::sort( std::string const & filename )
+  {
+    MappedFile               file( filename );
+    std::vector<GroceryItem> items = parse_grocery_items( file.bytes() );
+
+    std::vector<GroceryItem const *> shuffled;
+    shuffled.reserve( items.size() );
+    for( auto const & item : items ) shuffled.push_back( &item );
+    std::shuffle( shuffled.begin(), shuffled.end(), std::mt19937_64( 20'241'016 ) );
+
+    std::clog << "\n" << filename << ":  " << items.size() << " grocery items\n";
+
+    auto measure = [&]( std::string const & name, auto && less )
+    {
+      auto seconds = Benchmark::seconds( [&]
+      {
+        auto order = shuffled;
+        std::sort( order.begin(), order.end(), less );
+        Benchmark::do_not_optimize( order.data() );
+      }, 3 );
+      Benchmark::report( name, items.size(), seconds );
+    };
+
+    measure( "sort - strings compared (former operator<=>)", []( GroceryItem const * lhs, GroceryItem const * rhs ) { return string_compare( *lhs, *rhs ) < 0; } );
+    measure( "sort - operator<=>, sort keys first",          []( GroceryItem const * lhs, GroceryItem const * rhs ) { return *lhs < *rhs;                   } );
+  }
+
+
+
+
+  // Copying grocery items by value, as carts of them are copied, with strings of their own (GroceryItem) and without
+  // (CompactGroceryItem)
+  void GroceryItemBenchmark::copy( std::string const & filename )
+  {
+    MappedFile               file( filename );
+    std::vector<GroceryItem> items = parse_grocery_items( file.bytes() );
+    MonotonicArena           arena;
+
+    std::vector<CompactGroceryItem> compact;
+    compact.reserve( items.size() );
+    for( auto const & item : items ) compact.emplace_back( item, &arena );
+
+    std::clog << "\n" << filename << ":  " << items.size() << " grocery items\n";
+
+    // Copy the whole catalog, one item at a time, into storage already allocated, so only the items' own allocations are measured
+    auto copy_each = [&]( std::string const & name, auto const & source )
+    {
+      auto destination = source;
+      auto seconds = Benchmark::seconds( [&]
+      {
+        for( std::size_t i = 0; i < source.size(); ++i ) destination[i] = source[i];
+        Benchmark::do_not_optimize( destination.data() );
+      }, 3 );
+      Benchmark::report( name, source.size(), seconds );
+    };
+
+    // Copy a six item cart, the way trace() snapshots each cart after every move
+    auto copy_carts = [&]( std::string const & name, auto const & source )
+    {
+      using Item = typename std::decay_t<decltype( source )>::value_type;
+      constexpr std::size_t CARTS = 100'000;
+
+      std::stack<Item> cart;
+      for( std::size_t i = 0; i < 6 && i < source.size(); ++i ) cart.push( source[i * ( source.size() / 6 )] );
+
+      auto seconds = Benchmark::seconds( [&]
+      {
+        for( std::size_t i = 0; i < CARTS; ++i )
+        {
+          auto snapshot = cart;
+          Benchmark::do_not_optimize( snapshot.top() );
+        }
+      }, 3 );
+      Benchmark::report( name, CARTS, seconds );
+    };
+
+    copy_each ( "copy - GroceryItem, per item",                    items   );
+    copy_each ( "copy - CompactGroceryItem, per item",             compact );
+    copy_carts( "copy - cart of 6 GroceryItems, per cart",         items   );
+    copy_carts( "copy - cart of 6 CompactGroceryItems, per cart",  compact );
+
+    std::size_t inlineNames = 0;
+    for( auto const & item : compact ) inlineNames += ( item.productName().size() <= CompactGroceryItem::Name::INLINE_CAPACITY ) + ( item.brandName().size() <= CompactGroceryItem::Name::INLINE_CAPACITY );
+    std::clog << "  sizeof( GroceryItem ) = " << sizeof( GroceryItem ) << " bytes, sizeof( CompactGroceryItem ) = " << sizeof( CompactGroceryItem ) << " bytes, "
+              << 100.0 * static_cast<double>( inlineNames ) / static_cast<double>( 2 * std::max<std::size_t>( compact.size(), 1 ) ) << "% of names inline, "
+              << arena.bytes_allocated() / std::max<std::size_t>( compact.size(), 1 ) << " arena bytes per item\n";
+  }
+
+
+
+
+  GroceryItemBenchmark::GroceryItemBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Benchmarks:  Sorting a catalog\n";
+      for( auto const & filename : Benchmark::database_files() ) sort( filename );
+
+      std::clog << "\n\n\nGroceryItem Benchmarks:  Copying grocery items, with and without strings of their own\n";
+      for( auto const & filename : Benchmark::database_files() ) copy( filename );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"class GroceryItem\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
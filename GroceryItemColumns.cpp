@@ -0,0 +1,280 @@
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // int64_t, uint32_t, uint64_t
+#include <cstring>                                                            // memcpy()
+#include <limits>                                                             // numeric_limits
+#include <memory_resource>                                                    // monotonic_buffer_resource
+#include <span>
+#include <stdexcept>                                                          // length_error
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryItemColumns.hpp"
+#include "GroceryItemParser.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
+
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // Append field to a character pool and record where it ends
+  void append( std::string & pool, std::vector<std::uint32_t> & offsets, std::string_view field )
+  {
+    if( field.size() > std::numeric_limits<std::uint32_t>::max() - pool.size() )
+    {
+      throw std::length_error( "Error - Length error:  grocery item string pool exceeds 4 GiB" );
+    }
+    pool.append( field );
+    offsets.push_back( static_cast<std::uint32_t>( pool.size() ) );
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+/*******************************************************************************
+**  GroceryItemView
+*******************************************************************************/
+
+// Constructor
+GroceryItemView::GroceryItemView( GroceryItemColumns const & columns, std::size_t row ) noexcept
+  : _columns( &columns ), _row( row )
+{}
+
+
+
+
+// upcCode()
+std::string GroceryItemView::upcCode() const
+{
+  if( auto key = _columns->_upcKeys[_row];  key != 0 ) return Upc::from_key( key ).to_string();
+  return _columns->_unpackedUpcCodes.at( _row );
+}
+
+
+
+
+// brandName()
+std::string_view GroceryItemView::brandName() const noexcept
+{
+  return _columns->_brands[_columns->_brandIds[_row]];
+}
+
+
+
+
+// productName()
+std::string_view GroceryItemView::productName() const noexcept
+{
+  auto begin = _columns->_productOffsets[_row];
+  return std::string_view( _columns->_productPool ).substr( begin, _columns->_productOffsets[_row + 1] - begin );
+}
+
+
+
+
+// price()
+double GroceryItemView::price() const noexcept
+{
+  return _columns->_prices[_row].dollars();
+}
+
+
+
+
+// exactPrice()
+Money GroceryItemView::exactPrice() const noexcept
+{
+  return _columns->_prices[_row];
+}
+
+
+
+
+// operator GroceryItem()
+GroceryItemView::operator GroceryItem() const
+{
+  return GroceryItem( productName(), brandName(), upcCode(), exactPrice() );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  GroceryItemColumns - Constructors and Modifiers
+*******************************************************************************/
+
+// Construct from grocery items
+GroceryItemColumns::GroceryItemColumns( std::vector<GroceryItem> const & items )
+{
+  _upcKeys       .reserve( items.size()     );
+  _prices        .reserve( items.size()     );
+  _brandIds      .reserve( items.size()     );
+  _productOffsets.reserve( items.size() + 1 );
+
+  for( auto const & item : items ) push_back( item.upcCode(), item.brandName(), item.productName(), item.exactPrice() );
+}
+
+
+
+
+// Construct by parsing a grocery item database's text
+GroceryItemColumns::GroceryItemColumns( std::string_view databaseText )
+{
+  GroceryItemParser parser( databaseText );
+  for( GroceryItemRecord record; parser.next( record ); ) push_back( record.upcCode, record.brandName, record.productName, record.price );
+}
+
+
+
+
+// push_back()
+void GroceryItemColumns::push_back( std::string_view upcCode, std::string_view brandName, std::string_view productName, Money price )
+{
+  _brandIds.push_back( intern_brand( brandName ) );
+  append( _productPool, _productOffsets, productName );
+
+  auto const upc = Upc::parse( upcCode );
+  if( !upc ) _unpackedUpcCodes.emplace( _upcKeys.size(), upcCode );
+  _upcKeys.push_back( upc ? upc->key() : 0 );
+  _prices .push_back( price );
+}
+
+
+
+
+// intern_brand()
+std::uint32_t GroceryItemColumns::intern_brand( std::string_view brandName )
+{
+  if( auto brand = _brandLookup.find( brandName );  brand != _brandLookup.end() ) return brand->second;
+
+  auto characters = static_cast<char *>( _brandArena->allocate( brandName.size() + 1, alignof( char ) ) );   // never empty, so never null
+  std::memcpy( characters, brandName.data(), brandName.size() );
+
+  auto const id = static_cast<std::uint32_t>( _brands.size() );
+  _brands     .emplace_back( characters, brandName.size() );
+  _brandLookup.emplace     ( _brands.back(), id );
+  return id;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  GroceryItemColumns - Queries
+*******************************************************************************/
+
+// size()
+std::size_t GroceryItemColumns::size() const noexcept
+{
+  return _upcKeys.size();
+}
+
+
+
+
+// operator[]()
+GroceryItemView GroceryItemColumns::operator[]( std::size_t row ) const noexcept
+{
+  return GroceryItemView( *this, row );
+}
+
+
+
+
+// brand_count()
+std::size_t GroceryItemColumns::brand_count() const noexcept
+{
+  return _brands.size();
+}
+
+
+
+
+// upcKeys()
+std::span<std::uint64_t const> GroceryItemColumns::upcKeys() const noexcept
+{
+  return _upcKeys;
+}
+
+
+
+
+// prices()
+std::span<Money const> GroceryItemColumns::prices() const noexcept
+{
+  return _prices;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  GroceryItemColumns - Scans
+*******************************************************************************/
+
+// find()
+std::size_t GroceryItemColumns::find( Upc upc ) const noexcept
+{
+  // Compare a block of keys without branching so the compiler can vectorize it, and look for which one matched only after some did
+  constexpr std::size_t BLOCK = 8;
+
+  auto const  key  = upc.key();
+  auto const  keys = _upcKeys.data();
+  std::size_t row  = 0;
+
+  for( ; row + BLOCK <= _upcKeys.size(); row += BLOCK )
+  {
+    bool any = false;
+    for( std::size_t i = 0; i < BLOCK; ++i ) any |= keys[row + i] == key;
+    if( any ) break;
+  }
+
+  for( ; row < _upcKeys.size(); ++row ) if( keys[row] == key ) return row;
+  return npos;
+}
+
+
+
+
+// total_price()
+Money GroceryItemColumns::total_price() const noexcept
+{
+  // Integer addition is associative, so unlike a sum of doubles the compiler is free to vectorize this as it likes, and the total is
+  // exact whatever order the cents are added in
+  std::int64_t cents = 0;
+  for( auto price : _prices ) cents += price.cents();
+  return Money::from_cents( cents );
+}
+
+
+
+
+// count_priced_between()
+std::size_t GroceryItemColumns::count_priced_between( Money low, Money high ) const noexcept
+{
+  std::size_t count = 0;
+  for( auto price : _prices ) count += ( low.cents() <= price.cents() ) & ( price.cents() <= high.cents() );
+  return count;
+}
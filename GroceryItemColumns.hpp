@@ -0,0 +1,102 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t, uint64_t
+#include <limits>                                                             // numeric_limits
+#include <memory>                                                             // unique_ptr
+#include <memory_resource>                                                    // monotonic_buffer_resource
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
+
+
+
+
+class GroceryItemColumns;
+
+
+
+// A lightweight, read-only stand-in for one GroceryItem stored in GroceryItemColumns.  It is two words (the columns and a row
+// number), is cheap to copy, and reads each attribute from its column only when asked.  Views are invalidated when the columns
+// they refer to are destroyed.
+class GroceryItemView
+{
+  public:
+    GroceryItemView( GroceryItemColumns const & columns, std::size_t row ) noexcept;
+
+    // Accessors
+    std::string      upcCode    () const;                                     // rebuilt from the packed key, so returned by value
+    std::string_view brandName  () const noexcept;
+    std::string_view productName() const noexcept;
+    double           price      () const noexcept;                            // in dollars, see GroceryItem::price()
+    Money            exactPrice () const noexcept;
+
+    // Conversions
+    explicit operator GroceryItem() const;                                    // materialize a full, independent GroceryItem
+
+  private:
+    GroceryItemColumns const * _columns;
+    std::size_t                _row;
+};
+
+
+
+
+// Struct-of-arrays (columnar) storage for a catalog of grocery items.  Each attribute lives in its own dense array:
+//
+//   o)  UPC codes as packed 64-bit keys (see class Upc)
+//   o)  prices as whole cents (see class Money), so totals are exact integer sums
+//   o)  brands as small integers indexing a table of distinct brand names.  A brand like "Nature's Own" is stored once no matter
+//       how many items carry it, in a monotonic arena
+//   o)  product names back to back in a character pool, located by an offset array
+//
+// A scan reads only the column it needs, in order, so price aggregations and UPC searches stream through contiguous memory instead
+// of striding over whole GroceryItem objects and chasing pointers to their heap allocated strings.
+class GroceryItemColumns
+{
+  public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    // Constructors
+    GroceryItemColumns() = default;
+    explicit GroceryItemColumns( std::vector<GroceryItem> const & items );   // copy items into columns
+    explicit GroceryItemColumns( std::string_view databaseText );            // parse a grocery item database's text directly into columns, never building a GroceryItem
+
+    // Modifiers
+    void push_back( std::string_view upcCode, std::string_view brandName, std::string_view productName, Money price );
+
+    // Queries
+    std::size_t     size      () const noexcept;
+    GroceryItemView operator[]( std::size_t row ) const noexcept;
+    std::size_t     brand_count() const noexcept;                             // number of distinct brand names
+
+    std::span<std::uint64_t const> upcKeys() const noexcept;                  // Upc::key() of each row, zero if the row's UPC is not all digits
+    std::span<Money         const> prices () const noexcept;
+
+    // Scans
+    std::size_t find                 ( Upc upc ) const noexcept;              // first row with this UPC, npos if none
+    Money       total_price          () const noexcept;                       // sum of every row's price
+    std::size_t count_priced_between ( Money low, Money high ) const noexcept;     // number of rows with low <= price <= high
+
+  private:
+    friend class GroceryItemView;
+
+    std::uint32_t intern_brand( std::string_view brandName );
+
+    std::vector<std::uint64_t>                           _upcKeys;
+    std::vector<Money>                                   _prices;
+    std::vector<std::uint32_t>                           _brandIds;           // row i's brand is _brands[_brandIds[i]]
+    std::string                                          _productPool;
+    std::vector<std::uint32_t>                           _productOffsets{ 0 };   // row i's product is _productPool[_productOffsets[i], _productOffsets[i+1])
+    std::unordered_map<std::size_t, std::string>         _unpackedUpcCodes;   // the rare UPCs that can't be packed, by row
+
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> _brandArena = std::make_unique<std::pmr::monotonic_buffer_resource>();   // held by pointer so views of it survive moves
+    std::vector<std::string_view>                        _brands;             // distinct brand names, by id, viewing _brandArena
+    std::unordered_map<std::string_view, std::uint32_t>  _brandLookup;        // brand name -> id
+};
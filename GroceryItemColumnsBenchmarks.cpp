@@ -0,0 +1,102 @@
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iostream>                                                                         // clog
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemColumns.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemColumnsBenchmark
+  {
+    public:
+      GroceryItemColumnsBenchmark();
+
+    private:
+      void scan( std::string const & filename );
+  } run_groceryItemColumns_benchmarks;
+
+
+
+
+  // Run work() for its best time, then once more under the cache miss counter, and report both
+  template<typename Work>
+  void measure( std::string const & name, std::size_t operations, Work && work )
+  {
+    auto seconds = Benchmark::seconds( work );
+    auto misses  = Benchmark::cache_misses( work );
+    Benchmark::report_cache_misses( name, operations, seconds, misses );
+  }
+
+
+
+
+  // Whole catalog scans over a vector of GroceryItem (rows) vs. GroceryItemColumns (columns).  Per item, a row scan strides over a
+  // whole GroceryItem object, and a UPC compare follows the string to its characters, while a column scan reads 8 contiguous bytes.
+  void GroceryItemColumnsBenchmark::scan( std::string const & filename )
+  {
+    MappedFile               file( filename );
+    std::vector<GroceryItem> rows = parse_grocery_items( file.bytes() );
+    GroceryItemColumns       columns( rows );
+
+    std::clog << "\n" << filename << ":  " << rows.size() << " grocery items, " << sizeof( GroceryItem ) << " bytes per row object\n";
+    if( rows.empty() ) return;
+
+    auto const n = rows.size();
+
+    measure( "total price - rows", n, [&]
+    {
+      Money total;
+      for( auto const & item : rows ) total += item.exactPrice();
+      Benchmark::do_not_optimize( total );
+    } );
+    measure( "total price - columns", n, [&] { Benchmark::do_not_optimize( columns.total_price() ); } );
+
+    measure( "count priced between $1 and $5 - rows", n, [&]
+    {
+      std::size_t count = 0;
+      for( auto const & item : rows ) count += item.exactPrice() >= Money( 1.0 ) && item.exactPrice() <= Money( 5.0 );
+      Benchmark::do_not_optimize( count );
+    } );
+    measure( "count priced between $1 and $5 - columns", n, [&] { Benchmark::do_not_optimize( columns.count_priced_between( Money( 1.0 ), Money( 5.0 ) ) ); } );
+
+    // Search for the last item's UPC so every scan examines the whole catalog
+    auto const & upc = rows.back().upcCode();
+    auto const   key = Upc::parse( upc );
+
+    measure( "UPC scan - rows, string compare", n, [&]
+    {
+      std::size_t found = rows.size();
+      for( std::size_t i = 0; i < rows.size(); ++i ) if( rows[i].upcCode() == upc ) { found = i; break; }
+      Benchmark::do_not_optimize( found );
+    } );
+    if( key ) measure( "UPC scan - columns, packed key compare", n, [&] { Benchmark::do_not_optimize( columns.find( *key ) ); } );
+  }
+
+
+
+
+  GroceryItemColumnsBenchmark::GroceryItemColumnsBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Columns Benchmarks:  Rows vs. columns, whole catalog scans\n";
+      for( auto const & filename : Benchmark::database_files() ) scan( filename );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"class GroceryItemColumns\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
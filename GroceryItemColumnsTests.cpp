@@ -0,0 +1,121 @@
+#include <algorithm>                                                                        // find()
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemColumns.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
+
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemColumnsRegressionTest
+  {
+    public:
+      GroceryItemColumnsRegressionTest();
+
+    private:
+      void tests();
+
+      Regression::CheckResults affirm;
+  } run_groceryItemColumns_tests;
+
+
+
+
+  void GroceryItemColumnsRegressionTest::tests()
+  {
+    MappedFile file( "Grocery_UPC_Database-Small.dat" );
+    auto       items = parse_grocery_items( file.bytes() );
+    items.emplace_back( "grocery item's product name", "grocery item's brand name", "grocery item's UPC code", 123.79 );
+    items.emplace_back( "", "", "", 0.0 );
+
+    GroceryItemColumns columns( items );
+
+    {  // Every view reads back the item it was built from, field for field
+      bool identical = columns.size() == items.size();
+      for( std::size_t i = 0; identical && i < items.size(); ++i )
+      {
+        auto view = columns[i];
+        identical =    view.upcCode()     == std::string_view( items[i].upcCode() )
+                    && view.brandName()   == items[i].brandName()
+                    && view.productName() == items[i].productName()
+                    && view.price()       == items[i].price()
+                    && static_cast<GroceryItem>( view ) == items[i];
+      }
+      affirm.is_true( "Columns - views match the grocery items           ", identical );
+      affirm.is_equal( "Columns - unpacked UPC                            ", std::string( "grocery item's UPC code" ), columns[items.size() - 2].upcCode() );
+
+      std::vector<std::string_view> brands;
+      for( auto const & item : items ) if( std::find( brands.begin(), brands.end(), item.brandName() ) == brands.end() ) brands.push_back( item.brandName() );
+      affirm.is_equal( "Columns - each distinct brand stored once         ", brands.size(), columns.brand_count() );
+    }
+
+    {  // Parsing straight into columns gives the same columns
+      GroceryItemColumns parsed( file.bytes() );
+      bool               identical = parsed.size() + 2 == columns.size();
+      for( std::size_t i = 0; identical && i < parsed.size(); ++i ) identical = static_cast<GroceryItem>( parsed[i] ) == items[i];
+      affirm.is_true( "Columns - parsed directly from text               ", identical );
+    }
+
+    {  // Aggregations agree exactly with a row by row loop, to the cent
+      Money       total;
+      std::size_t count = 0;
+      for( auto const & item : items )
+      {
+        total += item.exactPrice();
+        count += item.exactPrice() >= Money( 1.0 ) && item.exactPrice() <= Money( 5.0 );
+      }
+      affirm.is_equal( "Columns - total price                             ", total, columns.total_price() );
+      affirm.is_equal( "Columns - count priced between                    ", count, columns.count_priced_between( Money( 1.0 ), Money( 5.0 ) ) );
+      affirm.is_equal( "Columns - empty total price                       ", Money(), GroceryItemColumns().total_price() );
+    }
+
+    {  // UPC scans find the first row with the UPC, at every position within a block
+      bool found = true;
+      for( std::size_t i = 0; i < items.size(); ++i )
+      {
+        if( auto upc = Upc::parse( items[i].upcCode() ) )
+        {
+          auto row = columns.find( *upc );
+          found = found && row <= i && items[row].upcCode() == items[i].upcCode();
+        }
+      }
+      affirm.is_true ( "Columns - UPC scan finds every item               ", found );
+      affirm.is_equal( "Columns - UPC scan miss                           ", GroceryItemColumns::npos, columns.find( Upc( "99999999999999999" ) ) );
+    }
+  }
+
+
+
+  GroceryItemColumnsRegressionTest::GroceryItemColumnsRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Columns Regression Test:\n";
+      tests();
+
+      std::clog << "\n\nGroceryItem Columns Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class GroceryItemColumns\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
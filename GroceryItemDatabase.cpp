@@ -1,36 +1,64 @@
 ///////////////////////// TO-DO (1) //////////////////////////////
 #include "GroceryItemDatabase.hpp"
 #include "GroceryItem.hpp"
-#include <fstream>
+#include "GroceryItemIndexes.hpp"
+#include "GroceryItemParser.hpp"
+#include "GroceryItemSearch.hpp"
+#include "GroceryItemSnapshot.hpp"
+#include "MappedFile.hpp"
+#include "UpcPerfectHash.hpp"
 #include <iostream>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
 /////////////////////// END-TO-DO (1) ////////////////////////////
 
 
 
-// Return a reference to the one and only instance of the database
-GroceryItemDatabase & GroceryItemDatabase::instance()
+// The database file instance() loads:  the most complete database in the current working directory, or its snapshot if that is
+// newer.  Empty if there is none.
+std::string GroceryItemDatabase::default_filename()
 {
-  // Want to probe for persistent database file only the first time called.  By making a (Lambda) function that returns the results
-  // of the probe and then calling that when fist construction the instance ensure all this probing stuff happens only the first
-  // time instance() is called.
-  auto getFileName = []()
+  std::string filename;
+
+  // Look for a prioritized list of database files in the current working directory to use
+  // Don't forget to #include <filesystem> to get visibility to the exists() function
+  if     ( filename = "Grocery_UPC_Database-Full.dat"  ;   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
+  else if( filename = "Grocery_UPC_Database-Large.dat" ;   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
+  else if( filename = "Grocery_UPC_Database-Medium.dat";   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
+  else if( filename = "Grocery_UPC_Database-Small.dat" ;   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
+  else if( filename = "Sample_GroceryItem_Database.dat";   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
+  else     filename.clear();
+
+  // A binary snapshot of the database (see GroceryItemSnapshot) loads far faster than the text it was made from, so prefer it as
+  // long as it is newer than the text file.  An older snapshot is stale and is ignored.
+  if( !filename.empty() )
   {
-    std::string filename;
-
-    // Look for a prioritized list of database files in the current working directory to use
-    // Don't forget to #include <filesystem> to get visibility to the exists() function
-    if     ( filename = "Grocery_UPC_Database-Full.dat"  ;   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
-    else if( filename = "Grocery_UPC_Database-Large.dat" ;   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
-    else if( filename = "Grocery_UPC_Database-Medium.dat";   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
-    else if( filename = "Grocery_UPC_Database-Small.dat" ;   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
-    else if( filename = "Sample_GroceryItem_Database.dat";   std::filesystem::exists( filename ) ) /* intentionally empty*/ ;
-    else     filename.clear();
-
-    return filename;
-  };
+    auto            snapshot = std::filesystem::path( filename ).replace_extension( ".snapshot" );
+    std::error_code snapshotError, textError;
+    auto            snapshotTime = std::filesystem::last_write_time( snapshot, snapshotError );
+    auto            textTime     = std::filesystem::last_write_time( filename, textError     );
+
+    if( !snapshotError && !textError && snapshotTime > textTime ) filename = snapshot.string();
+  }
+
+  return filename;
+}
+
+
 
-  static GroceryItemDatabase theInstance( getFileName() );
+
+// Return a reference to the one and only instance of the database
+GroceryItemDatabase & GroceryItemDatabase::instance()
+{
+  // The file is probed for, and the database loaded, only the first time instance() is called
+  static GroceryItemDatabase theInstance( default_filename(), std::max( 1U, std::thread::hardware_concurrency() ) );
   return theInstance;
 }
 
@@ -38,10 +66,10 @@ GroceryItemDatabase & GroceryItemDatabase::instance()
 
 
 // Construction
-GroceryItemDatabase::GroceryItemDatabase( const std::string & filename )
+GroceryItemDatabase::GroceryItemDatabase( const std::string & filename, std::size_t threads )
 {
-  std::ifstream fin( filename, std::ios::binary );
-  if( !fin.is_open() ) std::cerr << "Warning:  Could not open persistent grocery item database file \"" << filename << "\".  Proceeding with empty database\n\n";
+  MappedFile file( filename );
+  if( !file.is_open() ) std::cerr << "Warning:  Could not open persistent grocery item database file \"" << filename << "\".  Proceeding with empty database\n\n";
 
   // The file contains GroceryItems separated by whitespace.  A GroceryItem has 4 pieces of data delimited with a comma.  (This
   // exactly matches the previous assignment as to how GroceryItems are read)
@@ -60,17 +88,40 @@ GroceryItemDatabase::GroceryItemDatabase( const std::string & filename )
   //  Note: double quotes within the string are escaped with the backslash character
   //
 
-  ///////////////////////// TO-DO (2) //////////////////////////////
-  GroceryItem item;
-  while (fin >> item)
+  // A binary snapshot carries its own prebuilt index, so there is nothing to parse and nothing to hash.  A snapshot that fails
+  // validation (Ex: torn by a crash, or written by an incompatible version) is set aside for the text file it was made from, which
+  // default_filename() only passed over because the snapshot looked newer.
+  if( GroceryItemSnapshot::is_snapshot( file.bytes() ) )
   {
-    _dataStore.push_back(std::move(item));
+    if( GroceryItemSnapshot::read( file.bytes(), _dataStore, _index, &_arena ) ) return;
+
+    auto const source = std::filesystem::path( filename ).replace_extension( ".dat" ).string();
+    file = MappedFile( source );
+    if( source == filename || !file.is_open() || GroceryItemSnapshot::is_snapshot( file.bytes() ) )
+    {
+      std::cerr << "Warning:  Grocery item database snapshot \"" << filename << "\" is corrupt or from an incompatible version.  Proceeding with empty database\n\n";
+      return;
+    }
+
+    std::cerr << "Warning:  Grocery item database snapshot \"" << filename << "\" is corrupt or from an incompatible version.  Proceeding with \"" << source << "\"\n\n";
   }
+
+  ///////////////////////// TO-DO (2) //////////////////////////////
+  // The file is memory mapped and parsed in place, with the same grammar operator>> reads.  Fields are views of the mapped bytes
+  // (unescaped only when they contain an escape) and are copied exactly once, into the grocery item that keeps them.  Those copies
+  // are carved out of the database's arena, so a field too long to be stored inside its string costs no heap allocation of its own.
+  //
+  // Large files are split into chunks parsed concurrently by threads workers.  The chunks are merged in file order, so the data
+  // store is identical no matter how many threads do the work.
+  _dataStore = parse_grocery_items( file.bytes(), threads, std::size_t{ 1 } << 20, _arena );
   /////////////////////// END-TO-DO (2) ////////////////////////////
 
-  // Note:  The file is intentionally not explicitly closed.  The file is closed when fin goes out of scope - for whatever
-  //        reason.  More precisely, the object named "fin" is destroyed when it goes out of scope and the file is closed in the
-  //        destructor. See RAII
+  // Build the UPC index once, after the data store has stopped growing, so lookups are O(1) on average
+  _index = UpcIndex( _dataStore );
+
+  // Note:  The file is intentionally not explicitly unmapped.  The mapping is released when file goes out of scope - for whatever
+  //        reason.  More precisely, the object named "file" is destroyed when it goes out of scope and the mapping is released in
+  //        the destructor. See RAII
 }
 
 
@@ -82,22 +133,186 @@ GroceryItemDatabase::GroceryItemDatabase( const std::string & filename )
 
 
 ///////////////////////// TO-DO (3) //////////////////////////////
-GroceryItem *GroceryItemDatabase::find(const std::string &upc)
+GroceryItem *GroceryItemDatabase::find(std::string_view upc)
 {
-  return find(upc, 0);
+  if (is_frozen())
+  {
+    if (auto packed = Upc::parse(upc)) return find(*packed);
+  }
+
+  auto position = _index.find(_dataStore, upc);
+  return position == UpcIndex::npos ? nullptr : &_dataStore[position];
+}
+
+GroceryItem *GroceryItemDatabase::find(Upc upc)
+{
+  auto position = is_frozen() ? _frozen.find(upc) : _index.find(upc);
+  return position == UpcIndex::npos ? nullptr : &_dataStore[position];
 }
 
-GroceryItem *GroceryItemDatabase::find(const std::string &upc, std::size_t index)
+GroceryItem const *GroceryItemDatabase::find(std::string_view upc) const
 {
-  if (index >= _dataStore.size())
-    return nullptr;
-  if (_dataStore[index].upcCode() == upc)
-    return &_dataStore[index];
-  return find(upc, index + 1);
+  if (is_frozen())
+  {
+    if (auto packed = Upc::parse(upc)) return find(*packed);
+  }
+
+  auto position = _index.find(_dataStore, upc);
+  return position == UpcIndex::npos ? nullptr : &_dataStore[position];
+}
+
+GroceryItem const *GroceryItemDatabase::find(Upc upc) const
+{
+  auto position = is_frozen() ? _frozen.find(upc) : _index.find(upc);
+  return position == UpcIndex::npos ? nullptr : &_dataStore[position];
+}
+
+std::vector<GroceryItem *> GroceryItemDatabase::find_many(std::span<Upc const> upcs)
+{
+  std::vector<GroceryItem *> items(upcs.size(), nullptr);
+  if (is_frozen())
+  {
+    for (std::size_t i = 0; i < upcs.size(); ++i) items[i] = find(upcs[i]);  // one probe each already, nothing to overlap
+    return items;
+  }
+
+  auto positions = _index.find_many(upcs);
+  for (std::size_t i = 0; i < positions.size(); ++i) if (positions[i] != UpcIndex::npos) items[i] = &_dataStore[positions[i]];
+  return items;
+}
+
+std::unique_ptr<GroceryItemDatabase> GroceryItemDatabase::clone() const
+{
+  std::unique_ptr<GroceryItemDatabase> copy(new GroceryItemDatabase());       // the default constructor is private, so not make_unique()
+
+  copy->_dataStore.reserve(_dataStore.size());
+  for (auto const &item : _dataStore) copy->_dataStore.emplace_back(item, &copy->_arena);   // the copy's strings live in the copy's arena
+  copy->_index  = _index;                                                     // positions are unchanged, so the index carries over as is
+  copy->_frozen = _frozen;                                                    // and so does the perfect hash
+  return copy;
 }
 
 std::size_t GroceryItemDatabase::size() const
 {
   return _dataStore.size();
 }
+
+GroceryItemColumns GroceryItemDatabase::columns() const
+{
+  return GroceryItemColumns(_dataStore);
+}
+
+GroceryItemIndexes GroceryItemDatabase::indexes(std::size_t threads) const
+{
+  return GroceryItemIndexes(_dataStore, threads);
+}
+
+GroceryItemSearch GroceryItemDatabase::product_search() const
+{
+  return GroceryItemSearch(_dataStore);
+}
+
+bool GroceryItemDatabase::upsert(GroceryItem const &groceryItem)
+{
+  if (auto existing = find(groceryItem.upcCode()))
+  {
+    *existing = groceryItem;                                                  // assignment keeps the existing item's allocator, so the copy lands in the arena
+    return false;
+  }
+
+  _frozen = {};                                                               // a new UPC isn't in the perfect hash
+  _dataStore.emplace_back(groceryItem, &_arena);
+  _index.insert(_dataStore, _dataStore.size() - 1);
+  return true;
+}
+
+bool GroceryItemDatabase::erase(std::string_view upc)
+{
+  auto position = _index.find(_dataStore, upc);
+  if (position == UpcIndex::npos) return false;
+
+  _frozen = {};                                                               // an erased UPC is, and positions are about to change
+
+  // Fill the hole with the last item rather than shifting everything after it down
+  auto last = _dataStore.size() - 1;
+  _index.erase(_dataStore, position);
+  if (position != last)
+  {
+    _index.relocate(_dataStore, last, position);
+    _dataStore[position] = std::move(_dataStore[last]);
+  }
+  _dataStore.pop_back();
+  return true;
+}
+
+void GroceryItemDatabase::freeze()
+{
+  _frozen = UpcPerfectHash(_dataStore);
+}
+
+void GroceryItemDatabase::freeze(UpcPerfectHash::Tables const &tables)
+{
+  _frozen = UpcPerfectHash(tables, _dataStore);
+}
+
+bool GroceryItemDatabase::is_frozen() const noexcept
+{
+  return !_frozen.empty();
+}
+
+UpcPerfectHash::Tables GroceryItemDatabase::frozen_tables() const noexcept
+{
+  return _frozen.tables();
+}
+
+GroceryItemDatabase::DeltaCounts GroceryItemDatabase::apply_delta(std::istream &delta)
+{
+  struct Change
+  {
+    bool        erase;
+    GroceryItem groceryItem;                                                  // only the UPC is meaningful for an erase
+  };
+
+  std::vector<Change> changes;
+  for (std::size_t record = 1; delta >> std::ws, delta.peek() != std::istream::traits_type::eof(); ++record)
+  {
+    Change change{ delta.peek() == '-', {} };
+    if (change.erase)
+    {
+      std::string upc;                                                        // std::quoted() accepts an unquoted word too, so insist on the quote
+      if (delta.ignore() >> std::ws && delta.peek() == '"' && delta >> std::quoted(upc)) change.groceryItem.upcCode(upc);
+      else delta.setstate(std::ios::failbit);
+    }
+    else delta >> change.groceryItem;
+
+    if (!delta) throw std::invalid_argument("Error - Invalid argument:  malformed grocery item delta at record " + std::to_string(record));
+    changes.push_back(std::move(change));
+  }
+
+  DeltaCounts counts;
+  for (auto const &change : changes)
+  {
+    if      (change.erase)                   counts.erased += erase(change.groceryItem.upcCode());
+    else if (upsert(change.groceryItem))     ++counts.inserted;
+    else                                     ++counts.updated;
+  }
+  return counts;
+}
+
+GroceryItemDatabase::DeltaCounts GroceryItemDatabase::apply_delta(const std::string &filename)
+{
+  std::ifstream delta(filename);
+  if (!delta) throw std::invalid_argument("Error - Invalid argument:  could not open grocery item delta \"" + filename + '"');
+  return apply_delta(delta);
+}
+
+void GroceryItemDatabase::save_snapshot(const std::string &filename) const
+{
+  GroceryItemSnapshot::write(filename, _dataStore, _index);
+}
+
+void GroceryItemDatabase::compact(const std::string &filename) const
+{
+  GroceryItemSnapshot::write(filename, _dataStore, UpcIndex(_dataStore));
+}
 /////////////////////// END-TO-DO (3) ////////////////////////////
@@ -1,10 +1,22 @@
 #pragma once
 
 ///////////////////////// TO-DO (1) //////////////////////////////
+#include <iosfwd>                                                              // istream
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <algorithm>
+
+#include "GroceryItem.hpp"
+#include "GroceryItemColumns.hpp"
+#include "GroceryItemIndexes.hpp"
+#include "GroceryItemSearch.hpp"
+#include "MonotonicArena.hpp"
+#include "Upc.hpp"
+#include "UpcIndex.hpp"
+#include "UpcPerfectHash.hpp"
 /////////////////////// END-TO-DO (1) ////////////////////////////
 
 
@@ -14,20 +26,96 @@ class GroceryItemDatabase
   public:
     // Get a reference to the one and only instance of the database
     static GroceryItemDatabase & instance();
+    static std::string           default_filename();                           // the database file instance() loads, empty if none
+
+    // Construct a database from a particular file, either the quoted text format or a binary snapshot of it.  The application shares
+    // instance(), but tools, tests, and benchmarks need to open specific database files.  Large text files are parsed by up to
+    // threads worker threads, with identical results.  A snapshot that fails validation is passed over for the text file it was
+    // made from, the one beside it with the same name ending in .dat, if there is one.
+    //
+    // Every item's strings are carved out of the database's arena, but each item keeps its own copy of its brand name:  a GroceryItem
+    // owns its strings, so items can't share one brand buffer.  Brand names are interned only in the columnar view (see columns()
+    // and GroceryItemColumns), which stores each distinct brand once.
+    explicit GroceryItemDatabase   ( const std::string & filename, std::size_t threads = 1 );
+
+    GroceryItemDatabase            ( const GroceryItemDatabase & ) = delete;    // intentionally prohibit making copies
+    GroceryItemDatabase & operator=( const GroceryItemDatabase & ) = delete;    // intentionally prohibit copy assignments
+
+    std::unique_ptr<GroceryItemDatabase> clone() const;                         // An independent deep copy, for the rare caller that really
+                                                                                // needs one (Ex: building the next version of a database
+                                                                                // shared with readers, see ConcurrentGroceryItemDatabase)
 
     // Locate and return a reference to a particular record
-    GroceryItem * find( const std::string & upc );                              // Returns a pointer to the item in the database if
-                                                                                // found, nullptr otherwise
+    GroceryItem * find( std::string_view upc );                                 // Returns a pointer to the item in the database if
+                                                                                // found, nullptr otherwise.  The UPC is the primary key
+                                                                                // and is indexed, so don't change it through this pointer
+    GroceryItem * find( Upc upc );                                              // Same, for an already packed UPC.  No parsing, no string
+                                                                                // compares, no allocations
+    std::vector<GroceryItem *> find_many( std::span<Upc const> upcs );          // Same, for a whole batch (Ex: a cart's worth of scans) at
+                                                                                // once.  One pointer per UPC, in order.  Faster than one
+                                                                                // find() after another because the lookups overlap
+    GroceryItem const * find( std::string_view upc ) const;                     // Read only lookups, for a database that is shared and must
+    GroceryItem const * find( Upc upc )              const;                     // not be modified
     // Queries
     std::size_t size() const;                                                   // Returns the number of items in the database
+    GroceryItemColumns columns() const;                                         // Returns a columnar copy of the database, in the same
+                                                                                // order, for scans and aggregations over whole columns
+    GroceryItemIndexes indexes( std::size_t threads = 1 ) const;                // Returns secondary indexes by brand, product name, and
+                                                                                // price (see GroceryItemIndexes), sorted by up to threads
+                                                                                // threads.  Invalidated by any update of the database
+    GroceryItemSearch  product_search() const;                                  // Returns a case-insensitive search of product and brand
+                                                                                // names by any part of a name (see GroceryItemSearch).
+                                                                                // Invalidated by any update of the database
+
+    // Static lookups, for a catalog read far more often than it changes.  A frozen database finds a packed UPC with a minimal perfect
+    // hash (see UpcPerfectHash):  exactly one probe and one key compare.  Inserting or erasing an item thaws it again, back to the
+    // UPC index, while updating an item in place (Ex: a price change) does not.
+    void freeze();                                                              // Builds the perfect hash over every UPC in the database.
+                                                                                // When UPCs repeat, finds the first, as the UPC index does
+    void freeze( UpcPerfectHash::Tables const & tables );                       // Adopts one generated ahead of time for this database's
+                                                                                // file (see UpcPerfectHashGenerator).  Throws
+                                                                                // std::invalid_argument if it hashes any other set of UPCs
+    bool is_frozen() const noexcept;
+    UpcPerfectHash::Tables frozen_tables() const noexcept;                      // The perfect hash's tables while frozen, for generating
+                                                                                // C++ from them.  Empty otherwise
+
+    // Incremental updates, keyed by UPC.  Each costs O(1) on average, no matter how large the database.  Pointers returned by find()
+    // may be invalidated, and the order of the data store changes (the last item fills the hole left by an erased one).
+    struct DeltaCounts
+    {
+      std::size_t inserted = 0;
+      std::size_t updated  = 0;
+      std::size_t erased   = 0;
+    };
+
+    bool        upsert     ( GroceryItem const & groceryItem );                 // Inserts groceryItem, or replaces the item with its UPC.
+                                                                                // Returns true if inserted
+    bool        erase      ( std::string_view upc );                            // Removes the item with upc.  Returns false if not found
+    DeltaCounts apply_delta( std::istream & delta );                            // Applies a delta, in order:  records in the same quoted
+    DeltaCounts apply_delta( const std::string & filename );                    // format operator>> reads are upserts, and a quoted UPC
+                                                                                // preceded by a minus sign is an erase.  Ex:
+                                                                                //    "00024600017008", "Morton", "Morton Kosher Salt", 15.49
+                                                                                //    - "00033674100066"
+                                                                                // The whole delta is read before any of it is applied, so
+                                                                                // a malformed delta throws std::invalid_argument and
+                                                                                // changes nothing
+
+    // Persistence
+    void save_snapshot( const std::string & filename ) const;                  // Writes a binary snapshot instance() will prefer over the
+                                                                                // text file it was made from while the snapshot is newer
+    void compact      ( const std::string & filename ) const;                  // Same, merging the deltas applied so far into a fresh base:
+                                                                                // the index is rebuilt, free of erased UPCs.  Reloading it
+                                                                                // also reclaims memory held by replaced strings
 
   private:
-    GroceryItemDatabase            ( const std::string & filename );
+    GroceryItemDatabase() = default;                                            // an empty database, for clone()
 
-    GroceryItemDatabase            ( const GroceryItemDatabase & ) = delete;    // intentionally prohibit making copies
-    GroceryItemDatabase & operator=( const GroceryItemDatabase & ) = delete;    // intentionally prohibit copy assignments
+    MonotonicArena           _arena;     // Where the grocery items' strings live.  Declared first so it is destroyed last
 
     ///////////////////////// TO-DO (2) //////////////////////////////
     std::vector<GroceryItem> _dataStore; // Memory-resident data store
     /////////////////////// END-TO-DO (2) ////////////////////////////
+
+    UpcIndex                 _index;     // UPC -> position in _dataStore, built once after the data store is loaded
+    UpcPerfectHash           _frozen;    // UPC -> position in _dataStore while frozen, empty otherwise
 };
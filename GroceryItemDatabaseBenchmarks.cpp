@@ -0,0 +1,361 @@
+#include <algorithm>                                                                        // min(), shuffle()
+#include <cstddef>                                                                          // size_t
+#include <cstdint>                                                                          // uint32_t, uint64_t
+#include <exception>
+#include <filesystem>                                                                       // file_size(), temp_directory_path(), remove()
+#include <fstream>                                                                          // ifstream
+#include <iostream>                                                                         // clog
+#include <memory>                                                                           // make_shared()
+#include <random>                                                                           // mt19937_64
+#include <sstream>                                                                          // istringstream, ostringstream
+#include <span>
+#include <string>                                                                           // to_string()
+#include <string_view>
+#include <thread>                                                                           // hardware_concurrency()
+#include <utility>                                                                          // move()
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemColumns.hpp"
+#include "GroceryItemDatabase.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "MonotonicArena.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
+#include "UpcIndex.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemDatabaseBenchmark
+  {
+    public:
+      GroceryItemDatabaseBenchmark();
+
+    private:
+      void load  ( std::string const & filename );
+      void memory( std::string const & filename );
+      void lookup( std::string const & filename );
+      void delta ( std::string const & filename );
+      void scan  ( std::string const & filename );
+  } run_groceryItemDatabase_benchmarks;
+
+
+
+
+  // The lookup GroceryItemDatabase::find() used before the UPC index:  examine each record in turn until the UPC matches.  (The
+  // original was written recursively, one frame per record, but did the same work.)
+  GroceryItem const * linear_scan( std::vector<GroceryItem> const & dataStore, std::string_view upc )
+  {
+    for( auto const & item : dataStore ) if( item.upcCode() == upc ) return &item;
+    return nullptr;
+  }
+
+
+
+
+  // Cold start load time:  the former std::ifstream/operator>> loop vs. the memory mapped in place parser, with the file evicted from
+  // the page cache before every run.  Parsing alone, without building grocery items, shows how close the parser runs to disk speed.
+  void GroceryItemDatabaseBenchmark::load( std::string const & filename )
+  {
+    auto const bytes = std::filesystem::file_size( filename );
+    auto const items   = for_each_grocery_item( filename, []( GroceryItemRecord const & ) {} );
+
+    std::clog << "\n" << filename << ":  " << bytes << " bytes, " << items << " grocery items\n";
+
+    auto streamed = Benchmark::seconds( [&]
+    {
+      Benchmark::evict_from_page_cache( filename );
+      std::ifstream            fin( filename, std::ios::binary );
+      std::vector<GroceryItem> dataStore;
+      for( GroceryItem item; fin >> item; ) dataStore.push_back( std::move( item ) );
+      Benchmark::do_not_optimize( dataStore.data() );
+    }, 3 );
+    Benchmark::report_bandwidth( "load - std::ifstream and operator>> (former loader)", bytes, streamed );
+
+    for( std::size_t threads = 1;  ;  threads = std::min<std::size_t>( threads * 2, std::thread::hardware_concurrency() ) )
+    {
+      auto mapped = Benchmark::seconds( [&]
+      {
+        Benchmark::evict_from_page_cache( filename );
+        GroceryItemDatabase db( filename, threads );
+        Benchmark::do_not_optimize( db.size() );
+      }, 3 );
+      Benchmark::report_bandwidth( "load - GroceryItemDatabase, mapped and indexed, " + std::to_string( threads ) + " thread(s)", bytes, mapped );
+
+      if( threads >= std::thread::hardware_concurrency() ) break;
+    }
+
+    auto const snapshot = ( std::filesystem::temp_directory_path() / "GroceryItemDatabaseBenchmarks.snapshot" ).string();
+    GroceryItemDatabase( filename ).save_snapshot( snapshot );
+    auto restored = Benchmark::seconds( [&]
+    {
+      Benchmark::evict_from_page_cache( snapshot );
+      GroceryItemDatabase db( snapshot );
+      Benchmark::do_not_optimize( db.size() );
+    }, 3 );
+    Benchmark::report_bandwidth( "load - GroceryItemDatabase, binary snapshot (text MB/s)", bytes, restored );
+    std::filesystem::remove( snapshot );
+
+    auto parsed = Benchmark::seconds( [&]
+    {
+      Benchmark::evict_from_page_cache( filename );
+      MappedFile        file( filename );
+      GroceryItemParser parser( file.bytes() );
+      std::size_t       count = 0;
+      for( GroceryItemRecord record; parser.next( record ); ) ++count;
+      Benchmark::do_not_optimize( count );
+    }, 3 );
+    Benchmark::report_bandwidth( "parse only - mapped, in place", bytes, parsed );
+  }
+
+
+
+
+  // Resident memory and load time of the grocery items' strings:  one heap allocation per long field (the former loader) vs. every
+  // field carved out of one monotonic arena vs. columns with each distinct brand stored once.  The file is mapped and read once
+  // beforehand, so its pages are already part of the baseline.
+  void GroceryItemDatabaseBenchmark::memory( std::string const & filename )
+  {
+    MappedFile  file( filename );
+    auto const  threads = std::max( 1U, std::thread::hardware_concurrency() );
+    std::size_t items   = 0;
+    {
+      GroceryItemParser parser( file.bytes() );
+      for( GroceryItemRecord record; parser.next( record ); ) ++items;
+    }
+
+    std::clog << "\n" << filename << ":  " << items << " grocery items\n";
+
+    auto measure = [&]( std::string const & name, auto && load )
+    {
+      auto const seconds = Benchmark::seconds( [&] { Benchmark::do_not_optimize( load().get() ); }, 3 );
+
+      auto const before = Benchmark::resident_bytes();
+      auto const loaded = load();
+      auto const after  = Benchmark::resident_bytes();
+      Benchmark::do_not_optimize( loaded.get() );
+      Benchmark::report_memory( name, items, after > before ? after - before : 0, seconds );
+    };
+
+    measure( "strings on the heap, field by field (former loader)", [&]
+    {
+      return std::make_shared<std::vector<GroceryItem>>( parse_grocery_items( file.bytes(), threads ) );
+    } );
+
+    measure( "strings in a monotonic arena", [&]
+    {
+      struct Loaded { MonotonicArena arena;  std::vector<GroceryItem> items; };
+      auto loaded   = std::make_shared<Loaded>();
+      loaded->items = parse_grocery_items( file.bytes(), threads, std::size_t{ 1 } << 20, loaded->arena );
+      return loaded;
+    } );
+
+    measure( "columns, brands interned", [&]
+    {
+      return std::make_shared<GroceryItemColumns>( file.bytes() );
+    } );
+  }
+
+
+
+
+  // Lookup throughput, indexed vs. linear scan, over a shuffled mix of every UPC in the file plus an equal number of misses
+  void GroceryItemDatabaseBenchmark::lookup( std::string const & filename )
+  {
+    GroceryItemDatabase      db( filename );
+    std::vector<GroceryItem> dataStore;
+    {
+      std::ifstream fin( filename, std::ios::binary );
+      for( GroceryItem item; fin >> item; ) dataStore.push_back( std::move( item ) );
+    }
+
+    std::vector<std::string> queries;
+    queries.reserve( dataStore.size() * 2 );
+    for( auto const & item : dataStore )
+    {
+      std::string upc( item.upcCode() );
+      if( upc.size() >= Upc::MAX_DIGITS ) continue;
+
+      queries.push_back( upc );
+      queries.push_back( std::string( Upc::MAX_DIGITS - upc.size(), '9' ) + upc );          // longer than any UPC in the catalog, so a guaranteed miss and the scan's worst case
+    }
+    std::shuffle( queries.begin(), queries.end(), std::mt19937_64{ 20'240'229 } );
+
+    std::clog << "\n" << filename << ":  " << db.size() << " grocery items\n";
+
+    auto indexed = Benchmark::seconds( [&] { for( auto const & upc : queries ) Benchmark::do_not_optimize( db.find( upc ) ); } );
+    Benchmark::report( "find( string ) - hash index", queries.size(), indexed );
+
+    std::vector<Upc> packedQueries;
+    packedQueries.reserve( queries.size() );
+    for( auto const & upc : queries ) packedQueries.push_back( Upc( upc ) );
+
+    auto packed = Benchmark::seconds( [&] { for( auto upc : packedQueries ) Benchmark::do_not_optimize( db.find( upc ) ); } );
+    Benchmark::report( "find( Upc ) - packed keys, SIMD probe", packedQueries.size(), packed );
+
+    for( std::size_t batchSize : { std::size_t{ 8 }, std::size_t{ 64 }, packedQueries.size() } )
+    {
+      auto batched = Benchmark::seconds( [&]
+      {
+        for( std::size_t i = 0; i < packedQueries.size(); i += batchSize )
+        {
+          auto batch = std::span<Upc const>( packedQueries ).subspan( i, std::min( batchSize, packedQueries.size() - i ) );
+          Benchmark::do_not_optimize( db.find_many( batch ).data() );
+        }
+      } );
+      Benchmark::report( "find_many( Upc ) - batches of " + std::to_string( batchSize ) + ", prefetched", packedQueries.size(), batched );
+    }
+
+    // The miss path alone (Ex: a shopper's own item at checkout), where the Bloom filter in front of the index turns most UPCs away
+    // before the table is probed.  The false positive rate is the fraction of misses the filter lets through to the table.
+    std::vector<Upc> misses;
+    for( auto upc : packedQueries ) if( db.find( upc ) == nullptr ) misses.push_back( upc );
+
+    UpcIndex const index( dataStore );
+    std::size_t    falsePositives = 0;
+    for( auto upc : misses ) falsePositives += index.filter().might_contain( upc );
+
+    auto missed = Benchmark::seconds( [&] { for( auto upc : misses ) Benchmark::do_not_optimize( db.find( upc ) ); } );
+    Benchmark::report( "find( Upc ) - misses only, Bloom filter first", misses.size(), missed );
+    std::clog << "    Bloom filter:  " << index.filter().size_bytes() / 1e3 << " KB in front of a "
+              << index.capacity() * ( sizeof( std::uint64_t ) + sizeof( std::uint32_t ) ) / 1e3 << " KB table, "
+              << falsePositives << " of " << misses.size() << " misses (" << 100.0 * static_cast<double>( falsePositives ) / static_cast<double>( std::max<std::size_t>( misses.size(), 1 ) )
+              << "%) are false positives\n";
+
+    // The same lookups once the database is frozen:  a minimal perfect hash, one probe and one key compare each
+    auto frozen = Benchmark::seconds( [&] { db.freeze(); }, 1 );
+    Benchmark::report( "freeze() - build the minimal perfect hash", db.size(), frozen );
+
+    auto perfect = Benchmark::seconds( [&] { for( auto upc : packedQueries ) Benchmark::do_not_optimize( db.find( upc ) ); } );
+    Benchmark::report( "find( Upc ) - frozen, minimal perfect hash", packedQueries.size(), perfect );
+    auto perfectMisses = Benchmark::seconds( [&] { for( auto upc : misses ) Benchmark::do_not_optimize( db.find( upc ) ); } );
+    Benchmark::report( "find( Upc ) - frozen, misses only", misses.size(), perfectMisses );
+
+    // A scan over the larger catalogs takes milliseconds per query, so sample just enough queries for a stable average
+    std::size_t const scanQueries = std::min<std::size_t>( queries.size(), 20'000'000 / std::max<std::size_t>( dataStore.size(), 1 ) + 1 );
+    auto scanned = Benchmark::seconds( [&] { for( std::size_t i = 0; i < scanQueries; ++i ) Benchmark::do_not_optimize( linear_scan( dataStore, queries[i] ) ); }, 3 );
+    Benchmark::report( "linear scan (former find())", scanQueries, scanned );
+  }
+
+
+
+
+  // Applying a small batch of price changes as a delta vs. reloading the whole file to pick them up.  The delta costs the same no
+  // matter how large the catalog; the reload grows with it.
+  void GroceryItemDatabaseBenchmark::delta( std::string const & filename )
+  {
+    constexpr std::size_t CHANGES = 100;
+
+    GroceryItemDatabase db( filename );
+    MappedFile          file( filename );
+    auto                items = parse_grocery_items( file.bytes() );
+
+    std::ostringstream changes;
+    for( std::size_t i = 0; i < std::min( CHANGES, items.size() ); ++i )
+    {
+      auto & item = items[i * items.size() / CHANGES];
+      item.price( item.price() + 0.01 );
+      changes << item << '\n';
+    }
+    auto const deltaText = changes.str();
+
+    std::clog << "\n" << filename << ":  " << db.size() << " grocery items, " << std::min( CHANGES, items.size() ) << " changes\n";
+
+    auto applied = Benchmark::seconds( [&] { std::istringstream text( deltaText );  Benchmark::do_not_optimize( db.apply_delta( text ).updated ); } );
+    Benchmark::report( "apply_delta() - price changes in place", std::min( CHANGES, items.size() ), applied );
+
+    auto reloaded = Benchmark::seconds( [&] { GroceryItemDatabase fresh( filename );  Benchmark::do_not_optimize( fresh.size() ); }, 3 );
+    Benchmark::report( "reload the whole file", std::min( CHANGES, items.size() ), reloaded );
+  }
+
+
+
+
+  // One pass over the whole catalog (totaling every price) streamed batch by batch vs. loading every grocery item first.  The
+  // resident memory reported is the peak growth during the pass:  the stream holds only the batches in flight, while the load holds
+  // the whole catalog, however large.
+  void GroceryItemDatabaseBenchmark::scan( std::string const & filename )
+  {
+    auto const bytes   = static_cast<std::size_t>( std::filesystem::file_size( filename ) );
+    auto const threads = std::max( 1U, std::thread::hardware_concurrency() );
+
+    auto const items   = for_each_grocery_item( filename, []( GroceryItemRecord const & ) {} );
+
+    std::clog << "\n" << filename << ":  " << bytes << " bytes, " << items << " grocery items\n";
+
+    auto streamed = [&]( std::size_t workers, bool sample )
+    {
+      GroceryItemScanner scanner( filename, workers );
+      Money              total;
+      std::size_t        peak  = 0;
+      for( auto batch = scanner.next_batch();  !batch.empty();  batch = scanner.next_batch() )
+      {
+        for( auto const & record : batch ) total += record.price;
+        if( sample ) peak = std::max( peak, Benchmark::resident_bytes() );
+      }
+      Benchmark::do_not_optimize( total );
+      return peak;
+    };
+
+    for( std::size_t n = 1;  n <= threads;  n = ( n < threads ? threads : n + 1 ) )           // 1 thread, then all of them
+    {
+      auto const name    = "total price - streamed, " + std::to_string( n ) + " thread(s)";
+      auto const seconds = Benchmark::seconds( [&] { streamed( n, false ); } );
+      auto const before  = Benchmark::resident_bytes();
+      auto const peak    = streamed( n, true );
+      Benchmark::report_bandwidth( name, bytes, seconds );
+      Benchmark::report_memory   ( name, items, peak > before ? peak - before : 0, seconds );
+    }
+
+    auto loaded = [&]
+    {
+      MappedFile file( filename );
+      auto const all   = parse_grocery_items( file.bytes(), threads );
+      Money      total;
+      for( auto const & item : all ) total += item.exactPrice();
+      Benchmark::do_not_optimize( total );
+      return Benchmark::resident_bytes();
+    };
+
+    auto const name    = "total price - load every item first, " + std::to_string( threads ) + " thread(s)";
+    auto const seconds = Benchmark::seconds( [&] { loaded(); }, 3 );
+    auto const before  = Benchmark::resident_bytes();
+    auto const peak    = loaded();
+    Benchmark::report_bandwidth( name, bytes, seconds );
+    Benchmark::report_memory   ( name, items, peak > before ? peak - before : 0, seconds );
+  }
+
+
+
+
+  GroceryItemDatabaseBenchmark::GroceryItemDatabaseBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Database Benchmarks:  Cold start load\n";
+      for( auto const & filename : Benchmark::database_files() ) load( filename );
+
+      std::clog << "\n\n\nGroceryItem Database Benchmarks:  Resident memory\n";
+      for( auto const & filename : Benchmark::database_files() ) memory( filename );
+
+      std::clog << "\n\n\nGroceryItem Database Benchmarks:  UPC lookup\n";
+      for( auto const & filename : Benchmark::database_files() ) lookup( filename );
+
+      std::clog << "\n\n\nGroceryItem Database Benchmarks:  Incremental delta vs. reload\n";
+      for( auto const & filename : Benchmark::database_files() ) delta( filename );
+
+      std::clog << "\n\n\nGroceryItem Database Benchmarks:  Streaming scan vs. full load\n";
+      for( auto const & filename : Benchmark::database_files() ) scan( filename );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"class GroceryItemDatabase\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
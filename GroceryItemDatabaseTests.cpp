@@ -1,12 +1,20 @@
+#include <algorithm>                                                                      // all_of()
 #include <cstddef>                                                                        // size_t
 #include <exception>
-#include <filesystem>                                                                     // exists()
+#include <filesystem>                                                                     // exists(), temp_directory_path(), remove()
+#include <fstream>                                                                        // ofstream
 #include <iomanip>                                                                        // setprecision()
 #include <iostream>                                                                       // boolalpha(), showpoint(), fixed(), clog
+#include <sstream>                                                                        // istringstream
+#include <stdexcept>                                                                      // invalid_argument
+#include <string>
+#include <utility>                                                                        // move()
 #include <vector>
 
 #include "CheckResults.hpp"
 #include "GroceryItemDatabase.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
 
 
 
@@ -69,6 +77,171 @@ namespace  // anonymous
       affirm.is_equal( "Database query - search for a non-existent grocery item", nullptr, groceryItem );
     }
 
+    {  // A batch finds exactly what one find() after another does:  hits, misses, repeats, and in order
+      std::vector<Upc> upcs;
+      for( auto upc : { "00014100072331", "99999999999999999", "00072250018548", "00014100072331", "0", "00038000291210" } ) upcs.emplace_back( upc );
+      for( int i = 0; i < 40; ++i ) upcs.push_back( upcs[static_cast<std::size_t>( i ) * 7 % 6] );   // longer than the prefetch distance
+
+      auto items = db.find_many( upcs );
+      bool same  = items.size() == upcs.size();
+      for( std::size_t i = 0; same && i < upcs.size(); ++i ) same = items[i] == db.find( upcs[i] );
+
+      affirm.is_true( "Database query - batch matches one at a time", same );
+      affirm.is_true( "Database query - empty batch", db.find_many( {} ).empty() );
+    }
+
+    {  // Deltas upsert and erase in place, in order, and compact into a snapshot equal to the database they were applied to
+      GroceryItemDatabase delta( "Grocery_UPC_Database-Small.dat" );
+      auto const          originalSize = delta.size();
+
+      std::istringstream changes( R"("00072250018548", "Nature's Own", "Nature's Own Butter Buns Hotdog - 8 Ct", 11.29
+                                     "99999999999999999", "New Brand", "New Product", 1.99
+                                     "NOT-A-UPC", "Odd Brand", "Odd Product", 2.49
+                                     - "00028000517205"
+                                     - "00000000000000"
+                                     "NOT-A-UPC", "Odd Brand", "Odd Product", 2.99
+                                     -"99999999999999999")" );
+      auto counts = delta.apply_delta( changes );
+
+      affirm.is_equal( "Database delta - inserted", std::size_t( 2 ), counts.inserted );
+      affirm.is_equal( "Database delta - updated",  std::size_t( 2 ), counts.updated  );
+      affirm.is_equal( "Database delta - erased",   std::size_t( 2 ), counts.erased   );
+      affirm.is_equal( "Database delta - size",     originalSize,      delta.size()    );
+      affirm.is_equal( "Database delta - upsert updates existing item", 11.29, delta.find( "00072250018548" )->price() );
+      affirm.is_equal( "Database delta - upsert inserts unpacked UPC",  2.99,  delta.find( "NOT-A-UPC"      )->price() );
+      affirm.is_equal( "Database delta - erase",                        nullptr, delta.find( "00028000517205" )  );
+      affirm.is_equal( "Database delta - erase after insert",           nullptr, delta.find( "99999999999999999" ) );
+
+      // Erase almost everything and put it back, so tombstones pile up and are cleared by a rehash along the way
+      MappedFile file( "Grocery_UPC_Database-Small.dat" );
+      auto       items = parse_grocery_items( file.bytes() );
+      GroceryItemDatabase reference( "Grocery_UPC_Database-Small.dat" );
+      for( auto const & item : items ) delta.erase( item.upcCode() );
+      for( auto const & item : items ) delta.upsert( *reference.find( item.upcCode() ) );
+      bool restored = delta.size() == originalSize + 1;                                     // plus NOT-A-UPC
+      for( auto const & item : items ) restored = restored && delta.find( item.upcCode() ) && *delta.find( item.upcCode() ) == *reference.find( item.upcCode() );
+      affirm.is_true( "Database delta - erase and reinsert everything", restored );
+
+      std::istringstream malformed( R"("00072250018548", "Nature's Own", "Nature's Own Butter Buns Hotdog - 8 Ct", 0.01
+                                       - 00028000517205)" );
+      bool thrown = false;
+      try                                     { delta.apply_delta( malformed ); }
+      catch( std::invalid_argument const & )  { thrown = true;                  }
+      affirm.is_true( "Database delta - malformed delta changes nothing", thrown && delta.find( "00072250018548" )->price() == items.front().price() );
+
+      auto const path = ( std::filesystem::temp_directory_path() / "GroceryItemDatabaseTests.snapshot" ).string();
+      delta.compact( path );
+      GroceryItemDatabase compacted( path );
+      bool same = compacted.size() == delta.size();
+      for( auto const & item : items ) same = same && *compacted.find( item.upcCode() ) == *delta.find( item.upcCode() );
+      affirm.is_true( "Database delta - compacted snapshot", same && compacted.find( "NOT-A-UPC" ) != nullptr );
+
+      delta.erase( "00028000517205" );
+      delta.save_snapshot( path );                                                          // an index still holding tombstones loads too
+      GroceryItemDatabase saved( path );
+      affirm.is_true( "Database delta - snapshot with erased UPCs", saved.size() == delta.size() && saved.find( "00028000517205" ) == nullptr && saved.find( "NOT-A-UPC" ) != nullptr );
+      std::filesystem::remove( path );
+    }
+
+    {  // A frozen database finds exactly what the UPC index does, until an insert or erase thaws it
+      GroceryItemDatabase frozen( "Grocery_UPC_Database-Small.dat" );
+      GroceryItemDatabase reference( "Grocery_UPC_Database-Small.dat" );
+      MappedFile          file( "Grocery_UPC_Database-Small.dat" );
+      auto const          items = parse_grocery_items( file.bytes() );
+
+      frozen.freeze();
+      bool same = frozen.is_frozen();
+      for( auto const & item : items )
+      {
+        auto found = frozen.find( item.upcCode() );
+        same = same && found != nullptr && *found == *reference.find( item.upcCode() );
+      }
+      for( auto upc : { "99999999999999999", "00014100072332", "0", "--------------" } ) same = same && frozen.find( upc ) == nullptr;
+      affirm.is_true( "Database frozen - finds every UPC, and no others", same );
+
+      std::vector<Upc> upcs = { Upc( "00072250018548" ), Upc( "99999999999999999" ), Upc( "00028000517205" ) };
+      auto batch = frozen.find_many( upcs );
+      affirm.is_true( "Database frozen - batch", batch.size() == 3 && batch[0] == frozen.find( upcs[0] ) && batch[1] == nullptr && batch[2] == frozen.find( upcs[2] ) );
+
+      frozen.upsert( GroceryItem( "Nature's Own Butter Buns Hotdog - 8 Ct", "Nature's Own", "00072250018548", 11.29 ) );
+      affirm.is_true( "Database frozen - price change stays frozen", frozen.is_frozen() && frozen.find( "00072250018548" )->price() == 11.29 );
+
+      frozen.upsert( GroceryItem( "New Product", "New Brand", "99999999999999999", 1.99 ) );
+      affirm.is_true( "Database frozen - insert thaws", !frozen.is_frozen() && frozen.find( "99999999999999999" ) != nullptr );
+
+      frozen.freeze();
+      frozen.erase( "99999999999999999" );
+      affirm.is_true( "Database frozen - erase thaws", !frozen.is_frozen() && frozen.find( "99999999999999999" ) == nullptr && frozen.find( "00072250018548" ) != nullptr );
+
+      // Tables generated from one database adopt into another loaded from the same file, but not one with different UPCs
+      UpcPerfectHash const generated( items );                                              // the file's items, in the order the database loads them
+      GroceryItemDatabase  adopter( "Grocery_UPC_Database-Small.dat" );
+      adopter.freeze( generated.tables() );
+      affirm.is_true( "Database frozen - adopt generated tables", adopter.is_frozen() && adopter.find( "00072250018548" ) != nullptr );
+
+      frozen.erase( "00028000517205" );
+      bool thrown = false;
+      try                                     { frozen.freeze( generated.tables() ); }
+      catch( std::invalid_argument const & )  { thrown = true;                       }
+      affirm.is_true( "Database frozen - reject tables for other UPCs", thrown && !frozen.is_frozen() );
+    }
+
+    {  // A repeated UPC freezes too, and frozen or not the first item with it is found, as the UPC index finds it
+      auto const path = ( std::filesystem::temp_directory_path() / "GroceryItemDatabaseTests-Repeated.dat" ).string();
+      {
+        std::ofstream file( path );
+        file << "\"00072250018548\", \"First Brand\", \"First Product\", 1.99\n"
+             << "\"00072250018548\", \"Second Brand\", \"Second Product\", 2.99\n";
+      }
+
+      GroceryItemDatabase repeated( path );
+      auto const          unfrozen = repeated.find( "00072250018548" );
+      bool                same     = repeated.size() == 2 && unfrozen != nullptr && unfrozen->brandName() == "First Brand";
+
+      repeated.freeze();
+      auto const frozen = repeated.find( "00072250018548" );                                // the data store doesn't change, so unfrozen is still valid
+      affirm.is_true( "Database frozen - repeated UPC finds the first", same && repeated.is_frozen() && frozen == unfrozen );
+
+      GroceryItemDatabase adopter( path );
+      adopter.freeze( repeated.frozen_tables() );
+      affirm.is_true( "Database frozen - repeated UPC adopts tables", adopter.is_frozen() && adopter.find( "00072250018548" )->brandName() == "First Brand" );
+      std::filesystem::remove( path );
+    }
+
+    {  // Depth safety.  Lookups in a million item database, misses especially, walked a million deep when find() recursed once per
+       // item, and overflowed the stack unless the compiler turned the recursion into a loop (it doesn't at -O0).  Every lookup path,
+       // including the linear search of UPCs that aren't all digits, must take the same few frames no matter the database's size.
+      constexpr std::size_t RECORDS  = 1'000'000;
+      constexpr std::size_t UNPACKED = 1'000;
+      auto const            path     = ( std::filesystem::temp_directory_path() / "GroceryItemDatabaseTests-Million.dat" ).string();
+      {
+        std::ofstream file( path );
+        for( std::size_t i = 0; i < RECORDS - UNPACKED; ++i ) file << "\"" << 30'000'000'000'000 + i << "\", \"Brand\", \"Product\", 1.99\n";
+        for( std::size_t i = 0; i < UNPACKED;           ++i ) file << "\"SKU-" << i << "\", \"Brand\", \"Product\", 1.99\n";
+      }
+
+      GroceryItemDatabase million( path, 4 );
+      std::filesystem::remove( path );
+      affirm.is_equal( "Database depth - a million items loaded", RECORDS, million.size() );
+
+      bool missed = true;
+      for( std::size_t i = 0; i < 1'000; ++i )
+      {
+        auto const upc = std::to_string( 40'000'000'000'000 + i * 7'919 );
+        missed = missed && million.find( upc ) == nullptr && million.find( Upc( upc ) ) == nullptr;
+      }
+      affirm.is_true( "Database depth - misses", missed );
+      affirm.is_true( "Database depth - unpacked misses", million.find( "SKU-MISSING" ) == nullptr && million.find( "" ) == nullptr );
+      affirm.is_true( "Database depth - last items found", million.find( "30000000998999" ) != nullptr && million.find( "SKU-999" ) != nullptr );
+
+      std::vector<Upc> batch( 1'000, Upc( "99999999999999999" ) );
+      auto const       found = million.find_many( batch );
+      affirm.is_true( "Database depth - batch of misses", std::all_of( found.begin(), found.end(), []( GroceryItem * item ) { return item == nullptr; } ) );
+
+      million.freeze();
+      affirm.is_true( "Database depth - frozen misses", million.find( Upc( "99999999999999999" ) ) == nullptr && million.find( "SKU-MISSING" ) == nullptr );
+    }
+
     {
       // Grocery Item Database over Vector:
       //
@@ -80,7 +253,10 @@ namespace  // anonymous
       // GroceryItemDatabase I ensure proper attribute alignment and offset while gaining visibility.
       struct Attributes                                                                         // must exactly match the type and order of GroceryItemDatabase's instance attributes
       {
+        MonotonicArena           testArena;                                                     // replacement test data doesn't use it
         std::vector<GroceryItem> testData;
+        UpcIndex                 testIndex;                                                     // must be rebuilt whenever testData is replaced
+        UpcPerfectHash           testFrozen;                                                    // empty, db is never frozen here
       };
 
       // Let's do a little sanity checking to verify the GroceryItemDatabase and the Attribute classes at lest have the same size.
@@ -96,15 +272,19 @@ namespace  // anonymous
         auto & DB_attributes = reinterpret_cast<Attributes &>( db );                            // direct access to db's private parts
 
         std::vector<GroceryItem> originalData;
-        originalData.swap( DB_attributes.testData );                                            // save the original database so it can be restored later
+        UpcIndex                 originalIndex;
+        originalData .swap( DB_attributes.testData );                                           // save the original database so it can be restored later
+        originalIndex = std::move( DB_attributes.testIndex );
 
         // Attempt to find something from an empty database
         DB_attributes.testData.clear();
+        DB_attributes.testIndex = UpcIndex( DB_attributes.testData );
         auto groceryItem = db.find( "00014100072331" );
         affirm.is_equal( "Empty Database query - searching an empty database", nullptr, groceryItem );
 
 
-        DB_attributes.testData = { { "", "", "001" }, { "", "", "002" }, { "", "", "003" } };
+        DB_attributes.testData  = { { "", "", "001" }, { "", "", "002" }, { "", "", "003" } };
+        DB_attributes.testIndex = UpcIndex( DB_attributes.testData );
         groceryItem    = db.find( "003" );
         affirm.is_equal( "Database query - Searching for the last item", GroceryItem{ "", "", "003" }, *groceryItem );
 
@@ -112,7 +292,12 @@ namespace  // anonymous
         affirm.is_equal( "Database query - Searching for the first item", GroceryItem{ "", "", "001" }, *groceryItem );
 
 
+        groceryItem = db.find( "004" );
+        affirm.is_equal( "Database query - Searching for a missing item", nullptr, groceryItem );
+
+
         originalData.swap( DB_attributes.testData );                                            // restore the original database
+        DB_attributes.testIndex = std::move( originalIndex );
       }
     }
   }
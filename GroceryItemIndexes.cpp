@@ -0,0 +1,144 @@
+#include <algorithm>                                                          // partition_point()
+#include <compare>                                                            // operator<=>
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t
+#include <limits>                                                             // numeric_limits
+#include <numeric>                                                            // iota()
+#include <span>
+#include <stdexcept>                                                          // length_error
+#include <string_view>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryItemIndexes.hpp"
+#include "Money.hpp"
+#include "ParallelSort.hpp"
+
+
+
+
+/*******************************************************************************
+**  Construction
+*******************************************************************************/
+
+// Construct from grocery items
+GroceryItemIndexes::GroceryItemIndexes( std::span<GroceryItem const> items, std::size_t threads )
+  : _items( items )
+{
+  if( items.size() > std::numeric_limits<std::uint32_t>::max() ) throw std::length_error( "Too many grocery items to index" );
+
+  // Ties are broken by position, so each index is a strict total order and comes out the same whatever the number of threads
+  auto sorted = [&]( auto key )
+  {
+    Positions positions( items.size() );
+    std::iota( positions.begin(), positions.end(), std::uint32_t{ 0 } );
+
+    auto less = [&]( std::uint32_t lhs, std::uint32_t rhs )
+    {
+      auto cmp = key( items[lhs] ) <=> key( items[rhs] );
+      return cmp < 0 || ( cmp == 0 && lhs < rhs );
+    };
+    parallel_sort( positions.begin(), positions.end(), less, threads );
+    return positions;
+  };
+
+  _byBrandName   = sorted( []( GroceryItem const & item ) { return std::string_view( item.brandName() );   } );
+  _byProductName = sorted( []( GroceryItem const & item ) { return std::string_view( item.productName() ); } );
+  _byPrice       = sorted( []( GroceryItem const & item ) { return item.exactPrice();                      } );
+}
+
+
+
+
+// size()
+std::size_t GroceryItemIndexes::size() const noexcept
+{
+  return _items.size();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// ordered_by()
+std::vector<GroceryItem const *> GroceryItemIndexes::ordered_by( Key key ) const
+{
+  auto const & index = index_of( key );
+  return items_at( index.begin(), index.end() );
+}
+
+
+
+
+// with_brand()
+std::vector<GroceryItem const *> GroceryItemIndexes::with_brand( std::string_view brandName ) const
+{
+  auto const first = std::partition_point( _byBrandName.begin(), _byBrandName.end(), [&]( std::uint32_t i ) { return _items[i].brandName() <  brandName; } );
+  auto const last  = std::partition_point( first,                _byBrandName.end(), [&]( std::uint32_t i ) { return _items[i].brandName() == brandName; } );
+  return items_at( first, last );
+}
+
+
+
+
+// with_product_prefix()
+std::vector<GroceryItem const *> GroceryItemIndexes::with_product_prefix( std::string_view prefix ) const
+{
+  // Every name starting with prefix sorts at or after prefix itself, and before any name that doesn't but sorts after prefix
+  auto const first = std::partition_point( _byProductName.begin(), _byProductName.end(), [&]( std::uint32_t i ) { return _items[i].productName() < prefix;           } );
+  auto const last  = std::partition_point( first,                  _byProductName.end(), [&]( std::uint32_t i ) { return _items[i].productName().starts_with( prefix ); } );
+  return items_at( first, last );
+}
+
+
+
+
+// priced_between()
+std::vector<GroceryItem const *> GroceryItemIndexes::priced_between( Money low, Money high ) const
+{
+  auto const first = std::partition_point( _byPrice.begin(), _byPrice.end(), [&]( std::uint32_t i ) { return _items[i].exactPrice() <  low;  } );
+  auto const last  = std::partition_point( first,            _byPrice.end(), [&]( std::uint32_t i ) { return _items[i].exactPrice() <= high; } );
+  return items_at( first, last );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private Helpers
+*******************************************************************************/
+
+// index_of()
+GroceryItemIndexes::Positions const & GroceryItemIndexes::index_of( Key key ) const noexcept
+{
+  switch( key )
+  {
+    case Key::brandName:    return _byBrandName;
+    case Key::productName:  return _byProductName;
+    case Key::price:        break;
+  }
+  return _byPrice;
+}
+
+
+
+
+// items_at()
+std::vector<GroceryItem const *> GroceryItemIndexes::items_at( Positions::const_iterator first, Positions::const_iterator last ) const
+{
+  std::vector<GroceryItem const *> result;
+  result.reserve( static_cast<std::size_t>( last - first ) );
+  for( ; first != last; ++first ) result.push_back( &_items[*first] );
+  return result;
+}
@@ -0,0 +1,50 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "Money.hpp"
+
+
+
+
+// Secondary indexes over a catalog of grocery items, for reports that want items ordered or selected by something other than UPC
+// (Ex: every item of one brand, or every item priced between $1 and $5).  Each index is a permutation of the items' positions,
+// sorted by brand name, by product name, or by price, with ties in catalog order, so a range query is two binary searches and a
+// walk over exactly the items it returns, never a scan of the whole catalog.
+//
+// The indexes refer to the items they were built from (Ex: GroceryItemDatabase::indexes()), and are invalidated when those items
+// are modified, moved, or destroyed.  Building sorts the three permutations with up to threads worker threads (see parallel_sort()),
+// with identical results however many are used.
+class GroceryItemIndexes
+{
+  public:
+    enum class Key { brandName, productName, price };
+
+    // Constructors
+    GroceryItemIndexes() = default;
+    explicit GroceryItemIndexes( std::span<GroceryItem const> items, std::size_t threads = 1 );
+
+    // Queries.  Results are in index order:  by brand name, product name, or price, then catalog order
+    std::vector<GroceryItem const *> ordered_by    ( Key key )                      const;   // every item
+    std::vector<GroceryItem const *> with_brand    ( std::string_view brandName )   const;   // items whose brand is brandName, exactly
+    std::vector<GroceryItem const *> with_product_prefix( std::string_view prefix ) const;   // items whose product name starts with prefix
+    std::vector<GroceryItem const *> priced_between( Money low, Money high )        const;   // items with low <= price <= high
+
+    std::size_t size() const noexcept;
+
+  private:
+    using Positions = std::vector<std::uint32_t>;
+
+    Positions const &                index_of( Key key ) const noexcept;
+    std::vector<GroceryItem const *> items_at( Positions::const_iterator first, Positions::const_iterator last ) const;
+
+    std::span<GroceryItem const> _items;
+    Positions                    _byBrandName;
+    Positions                    _byProductName;
+    Positions                    _byPrice;
+};
@@ -0,0 +1,104 @@
+#include <algorithm>                                                                        // max()
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iostream>                                                                         // clog
+#include <string>
+#include <string_view>
+#include <thread>                                                                           // hardware_concurrency()
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemIndexes.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "Money.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemIndexesBenchmark
+  {
+    public:
+      GroceryItemIndexesBenchmark();
+
+    private:
+      void build  ( std::string const & filename );
+      void queries( std::string const & filename );
+  } run_groceryItemIndexes_benchmarks;
+
+
+
+
+  // Time to build all three indexes as the number of sorting threads grows
+  void GroceryItemIndexesBenchmark::build( std::string const & filename )
+  {
+    MappedFile const               file( filename );
+    std::vector<GroceryItem> const items = parse_grocery_items( file.bytes() );
+
+    std::clog << "\n" << filename << ":  " << items.size() << " grocery items, " << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    for( std::size_t threads : { 1, 2, 4, 8 } )
+    {
+      auto seconds = Benchmark::seconds( [&] { Benchmark::do_not_optimize( GroceryItemIndexes( items, threads ).size() ); }, 3 );
+      Benchmark::report( "build brand, product, and price indexes - " + std::to_string( threads ) + " thread(s)", items.size(), seconds );
+    }
+  }
+
+
+
+
+  // Range queries answered by the indexes vs. a scan of the whole catalog
+  void GroceryItemIndexesBenchmark::queries( std::string const & filename )
+  {
+    MappedFile const               file( filename );
+    std::vector<GroceryItem> const items = parse_grocery_items( file.bytes() );
+    if( items.empty() ) return;
+
+    GroceryItemIndexes const indexes( items, std::max( 1U, std::thread::hardware_concurrency() ) );
+    std::string_view const   brand = items[items.size() / 2].brandName();
+    Money const              low( 1.0 ), high( 1.5 );
+
+    std::clog << "\n" << filename << ":  " << indexes.with_brand( brand ).size() << " items of brand \"" << brand << "\", "
+              << indexes.priced_between( low, high ).size() << " priced between " << low << " and " << high << '\n';
+
+    auto scan = [&]( auto && keep )
+    {
+      std::vector<GroceryItem const *> result;
+      for( auto const & item : items ) if( keep( item ) ) result.push_back( &item );
+      return result;
+    };
+
+    auto seconds = Benchmark::seconds( [&] { Benchmark::do_not_optimize( scan( [&]( GroceryItem const & item ) { return item.brandName() == brand; } ).size() ); } );
+    Benchmark::report( "all items of a brand - full scan", 1, seconds );
+    seconds = Benchmark::seconds( [&] { Benchmark::do_not_optimize( indexes.with_brand( brand ).size() ); } );
+    Benchmark::report( "all items of a brand - brand index", 1, seconds );
+
+    seconds = Benchmark::seconds( [&] { Benchmark::do_not_optimize( scan( [&]( GroceryItem const & item ) { return low <= item.exactPrice() && item.exactPrice() <= high; } ).size() ); } );
+    Benchmark::report( "items priced between - full scan", 1, seconds );
+    seconds = Benchmark::seconds( [&] { Benchmark::do_not_optimize( indexes.priced_between( low, high ).size() ); } );
+    Benchmark::report( "items priced between - price index", 1, seconds );
+  }
+
+
+
+
+  GroceryItemIndexesBenchmark::GroceryItemIndexesBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Indexes Benchmarks:  Build time vs. threads\n";
+      for( auto const & filename : Benchmark::database_files() ) build( filename );
+
+      std::clog << "\n\n\nGroceryItem Indexes Benchmarks:  Range queries\n";
+      for( auto const & filename : Benchmark::database_files() ) queries( filename );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"class GroceryItemIndexes\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,179 @@
+#include <algorithm>                                                                        // sort(), is_sorted()
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <functional>                                                                       // less
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <random>                                                                           // mt19937_64, uniform_int_distribution
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>                                                                          // move(), pair
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemDatabase.hpp"
+#include "GroceryItemIndexes.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "Money.hpp"
+#include "ParallelSort.hpp"
+
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemIndexesRegressionTest
+  {
+    public:
+      GroceryItemIndexesRegressionTest();
+
+    private:
+      void sorting();
+      void queries();
+
+      Regression::CheckResults affirm;
+  } run_groceryItemIndexes_tests;
+
+
+
+
+  // The reference:  every item that satisfies keep(), in catalog order
+  template<typename Keep>
+  std::vector<GroceryItem const *> filter( std::vector<GroceryItem> const & items, Keep && keep )
+  {
+    std::vector<GroceryItem const *> result;
+    for( auto const & item : items ) if( keep( item ) ) result.push_back( &item );
+    return result;
+  }
+
+
+
+
+  // The parallel sort agrees with std::sort whatever the number of threads, including more threads than runs worth sorting and
+  // sizes that don't divide evenly
+  void GroceryItemIndexesRegressionTest::sorting()
+  {
+    std::mt19937_64                          random( 20'241'016 );
+    std::uniform_int_distribution<long long> pick( -1'000, 1'000 );                         // plenty of duplicates
+
+    bool allMatch = true;
+    for( std::size_t size : { 0, 1, 1'000, 100'003, 250'000 } )
+    {
+      std::vector<long long> values( size );
+      for( auto & value : values ) value = pick( random );
+
+      auto expected = values;
+      std::sort( expected.begin(), expected.end() );
+
+      for( std::size_t threads : { 1, 2, 3, 8, 64 } )
+      {
+        auto actual = values;
+        parallel_sort( actual.begin(), actual.end(), std::less<>{}, threads );
+        allMatch = actual == expected && allMatch;
+      }
+    }
+    affirm.is_true( "Parallel sort matches std::sort                   ", allMatch );
+  }
+
+
+
+
+  void GroceryItemIndexesRegressionTest::queries()
+  {
+    // Repeat the Small catalog, each copy at its own prices, until it is large enough that building the indexes really does sort in
+    // parallel
+    MappedFile               file( "Grocery_UPC_Database-Small.dat" );
+    auto const               small = parse_grocery_items( file.bytes() );
+    std::vector<GroceryItem> items;
+    for( std::size_t copy = 0; copy < 300 && !small.empty(); ++copy )
+    {
+      for( auto item : small ) items.push_back( std::move( item.price( Money::from_cents( item.exactPrice().cents() + static_cast<long long>( copy ) ) ) ) );
+    }
+
+    std::set<std::string_view> brands;
+    for( auto const & item : small ) brands.insert( item.brandName() );
+
+    GroceryItemIndexes const serial( items, 1 );
+
+    {  // Every item appears once in each index, in order, and the order doesn't depend on the number of threads
+      bool ordered = true;
+      auto check   = [&]( GroceryItemIndexes::Key key, auto && less )
+      {
+        auto const order = serial.ordered_by( key );
+        ordered = ordered && order.size() == items.size()
+                          && std::is_sorted( order.begin(), order.end(), [&]( auto lhs, auto rhs ) { return less( *lhs, *rhs ) || ( !less( *rhs, *lhs ) && lhs < rhs ); } )
+                          && GroceryItemIndexes( items, 4 ).ordered_by( key ) == order;
+      };
+      check( GroceryItemIndexes::Key::brandName,   []( GroceryItem const & lhs, GroceryItem const & rhs ) { return lhs.brandName  () < rhs.brandName  (); } );
+      check( GroceryItemIndexes::Key::productName, []( GroceryItem const & lhs, GroceryItem const & rhs ) { return lhs.productName() < rhs.productName(); } );
+      check( GroceryItemIndexes::Key::price,       []( GroceryItem const & lhs, GroceryItem const & rhs ) { return lhs.exactPrice () < rhs.exactPrice (); } );
+      affirm.is_true( "Indexes - ordered by brand, product, and price    ", ordered );
+    }
+
+    {  // Brand queries return exactly the items of that brand, in catalog order
+      bool allMatch = true;
+      for( auto brand : brands ) allMatch = allMatch && serial.with_brand( brand ) == filter( items, [&]( GroceryItem const & item ) { return item.brandName() == brand; } );
+      affirm.is_true ( "Indexes - every brand                             ", allMatch );
+      affirm.is_true ( "Indexes - unknown brand                           ", serial.with_brand( "No Such Brand" ).empty() && serial.with_brand( "" ).empty() );
+    }
+
+    {  // Product name prefixes
+      bool allMatch = true;
+      for( std::string_view prefix : { "", "K", "Kellogg's", "Nature's Own Butter Buns Hotdog - 8 Ct", "Nature's Own Butter Buns Hotdog - 8 Ctx", "zzz", "\xFF" } )
+      {
+        auto actual = serial.with_product_prefix( prefix );
+        std::sort( actual.begin(), actual.end() );                                          // compare as sets, catalog order
+        allMatch = allMatch && actual == filter( items, [&]( GroceryItem const & item ) { return item.productName().starts_with( prefix ); } );
+      }
+      affirm.is_true ( "Indexes - product name prefixes                   ", allMatch );
+    }
+
+    {  // Price ranges are inclusive at both ends, and empty when inverted
+      bool allMatch = true;
+      std::vector<std::pair<double, double>> const ranges = { { 1.0, 5.0 }, { 0.0, 0.0 }, { 10.79, 10.79 }, { 5.0, 1.0 }, { -1.0, 1e6 }, { 50.0, 55.55 } };
+      for( auto [low, high] : ranges )
+      {
+        auto actual = serial.priced_between( Money( low ), Money( high ) );
+        allMatch = allMatch && std::is_sorted( actual.begin(), actual.end(), []( auto lhs, auto rhs ) { return lhs->exactPrice() < rhs->exactPrice(); } );
+
+        std::sort( actual.begin(), actual.end() );
+        allMatch = allMatch && actual == filter( items, [&]( GroceryItem const & item ) { return Money( low ) <= item.exactPrice() && item.exactPrice() <= Money( high ); } );
+      }
+      affirm.is_true ( "Indexes - price ranges                            ", allMatch );
+    }
+
+    {  // The database hands out indexes over its own items
+      GroceryItemDatabase database( "Grocery_UPC_Database-Small.dat" );
+      auto const          indexes = database.indexes( 2 );
+      affirm.is_equal( "Indexes - from the database                       ", database.size(), indexes.ordered_by( GroceryItemIndexes::Key::price ).size() );
+      affirm.is_true ( "Indexes - empty                                   ", GroceryItemIndexes().with_brand( "Nestle" ).empty() && GroceryItemIndexes().size() == 0 );
+    }
+  }
+
+
+
+
+  GroceryItemIndexesRegressionTest::GroceryItemIndexesRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Indexes Regression Test:\n";
+      sorting();
+      queries();
+
+      std::clog << "\n\nGroceryItem Indexes Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class GroceryItemIndexes\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,612 @@
+#include <algorithm>                                                          // min(), max(), move()
+#include <atomic>
+#include <bit>                                                                // countr_zero()
+#include <charconv>                                                           // from_chars()
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint64_t
+#include <exception>                                                          // exception_ptr, current_exception(), rethrow_exception()
+#include <functional>                                                         // less_equal, less
+#include <iterator>                                                           // back_inserter()
+#include <memory_resource>                                                    // memory_resource
+#include <mutex>                                                              // mutex, scoped_lock
+#include <string>
+#include <string_view>
+#include <system_error>                                                       // errc
+#include <thread>                                                             // jthread
+#include <utility>                                                            // move()
+#include <vector>
+
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+  #include <immintrin.h>                                                      // _mm256_cmpeq_epi8(), _mm_movemask_epi8(), ...
+#endif
+
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "MonotonicArena.hpp"
+#include "Money.hpp"
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // The characters std::isspace() classifies as whitespace in the "C" locale, which is what operator>> skips
+  constexpr bool is_space( char c ) noexcept
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  constexpr bool is_digit( char c ) noexcept
+  {
+    return c >= '0' && c <= '9';
+  }
+
+
+
+  // Scanning a vector of bytes at a time.  Each function classifies every byte of a block at once and returns a bit mask, bit i set
+  // if byte i is one being searched for.  The scalar tail, and builds without SIMD, use the same classification one byte at a time.
+  #if defined( __AVX2__ )
+    constexpr std::size_t BLOCK_SIZE = 32;
+    using Block = __m256i;
+
+    inline Block    load        ( char const * p ) noexcept { return _mm256_loadu_si256( reinterpret_cast<__m256i const *>( p ) ); }
+    inline Block    splat       ( char c )         noexcept { return _mm256_set1_epi8( c ); }
+    inline Block    equal       ( Block a, Block b ) noexcept { return _mm256_cmpeq_epi8( a, b ); }
+    inline Block    either      ( Block a, Block b ) noexcept { return _mm256_or_si256( a, b ); }
+    inline Block    at_most     ( Block a, Block b ) noexcept { return _mm256_cmpeq_epi8( _mm256_min_epu8( a, b ), a ); }   // unsigned a <= b
+    inline Block    minus       ( Block a, Block b ) noexcept { return _mm256_sub_epi8( a, b ); }
+    inline unsigned mask_of     ( Block a )          noexcept { return static_cast<unsigned>( _mm256_movemask_epi8( a ) ); }
+
+  #elif defined( __SSE2__ )
+    constexpr std::size_t BLOCK_SIZE = 16;
+    using Block = __m128i;
+
+    inline Block    load        ( char const * p ) noexcept { return _mm_loadu_si128( reinterpret_cast<__m128i const *>( p ) ); }
+    inline Block    splat       ( char c )         noexcept { return _mm_set1_epi8( c ); }
+    inline Block    equal       ( Block a, Block b ) noexcept { return _mm_cmpeq_epi8( a, b ); }
+    inline Block    either      ( Block a, Block b ) noexcept { return _mm_or_si128( a, b ); }
+    inline Block    at_most     ( Block a, Block b ) noexcept { return _mm_cmpeq_epi8( _mm_min_epu8( a, b ), a ); }
+    inline Block    minus       ( Block a, Block b ) noexcept { return _mm_sub_epi8( a, b ); }
+    inline unsigned mask_of     ( Block a )          noexcept { return static_cast<unsigned>( _mm_movemask_epi8( a ) ); }
+  #endif
+
+
+
+  // The position of the first double quote or backslash at or after from, or buffer.size() if there is none.  These are the only
+  // bytes that end the run of ordinary characters inside a quoted field.
+  inline std::size_t find_quote_or_backslash( std::string_view buffer, std::size_t from ) noexcept
+  {
+    auto const data = buffer.data();
+    auto const size = buffer.size();
+
+    #if defined( __AVX2__ ) || defined( __SSE2__ )
+      auto const quote     = splat( '"'  );
+      auto const backslash = splat( '\\' );
+      for( ;  from + BLOCK_SIZE <= size;  from += BLOCK_SIZE )
+      {
+        auto const bytes = load( data + from );
+        if( auto mask = mask_of( either( equal( bytes, quote ), equal( bytes, backslash ) ) ) ) return from + static_cast<std::size_t>( std::countr_zero( mask ) );
+      }
+    #endif
+
+    while( from < size && data[from] != '"' && data[from] != '\\' ) ++from;
+    return from;
+  }
+
+
+
+  // The position of the first non-whitespace byte at or after from, or buffer.size() if there is none
+  inline std::size_t find_non_space( std::string_view buffer, std::size_t from ) noexcept
+  {
+    auto const data = buffer.data();
+    auto const size = buffer.size();
+
+    // Most gaps between fields are a byte or two, or nothing at all, so don't pay for a vector unless the gap is longer
+    for( auto const stop = std::min( size, from + 2 );  from < stop;  ++from ) if( !is_space( data[from] ) ) return from;
+
+    #if defined( __AVX2__ ) || defined( __SSE2__ )
+      auto const space    = splat( ' '  );
+      auto const tab      = splat( '\t' );
+      auto const controls = splat( '\r' - '\t' );                             // '\t' through '\r' are the other whitespace characters
+      for( ;  from + BLOCK_SIZE <= size;  from += BLOCK_SIZE )
+      {
+        auto const bytes = load( data + from );
+        auto const blank = either( equal( bytes, space ), at_most( minus( bytes, tab ), controls ) );
+        if( auto mask = ~mask_of( blank ) & ( ( std::uint64_t{ 1 } << BLOCK_SIZE ) - 1 ) ) return from + static_cast<std::size_t>( std::countr_zero( mask ) );
+      }
+    #endif
+
+    while( from < size && is_space( data[from] ) ) ++from;
+    return from;
+  }
+
+
+
+  // The grocery items parsed from one chunk of the buffer.  The chunk claims every record that starts in [start, bound).  end is
+  // where parsing actually stopped:  the first record start at or after bound, or the start of a malformed record.
+  struct Chunk
+  {
+    std::size_t              start  = 0;
+    std::size_t              bound  = 0;
+    std::size_t              end    = 0;
+    bool                     failed = false;
+    std::vector<GroceryItem> items;
+  };
+
+  void parse_chunk( std::string_view buffer, Chunk & chunk, GroceryItem::allocator_type allocator )
+  {
+    chunk.items.clear();
+    chunk.failed = false;
+
+    GroceryItemParser parser( buffer, chunk.start );
+    for( parser.skip_whitespace();  parser.offset() < chunk.bound;  parser.skip_whitespace() )
+    {
+      GroceryItemRecord record;
+      auto const        recordStart = parser.offset();
+      if( !parser.next( record ) )
+      {
+        chunk.failed = true;
+        chunk.end    = recordStart;
+        return;
+      }
+      chunk.items.emplace_back( record.productName, record.brandName, record.upcCode, record.price, allocator );
+    }
+    chunk.end = parser.offset();
+  }
+
+
+
+  // The first position at or after from that looks like the start of a record:  the first non-blank character of a line is a
+  // double quote followed by digits and a closing double quote, i.e. a quoted UPC.  Returns buffer.size() if there is none.
+  std::size_t resynchronize( std::string_view buffer, std::size_t from ) noexcept
+  {
+    for( auto newline = buffer.find( '\n', from == 0 ? 0 : from - 1 );  newline != std::string_view::npos;  newline = buffer.find( '\n', newline + 1 ) )
+    {
+      auto i = newline + 1;
+      while( i < buffer.size() && ( buffer[i] == ' ' || buffer[i] == '\t' || buffer[i] == '\r' ) ) ++i;
+      if( i >= buffer.size() || buffer[i] != '"' ) continue;
+
+      auto j = i + 1;
+      while( j < buffer.size() && is_digit( buffer[j] ) ) ++j;
+      if( j > i + 1 && j < buffer.size() && buffer[j] == '"' ) return i;
+    }
+    return buffer.size();
+  }
+
+
+
+  // parse_grocery_items() for either kind of resource.  The merge, and any re-parse it needs, allocates from resource;  each worker
+  // allocates from the resource worker_resource() gives it.
+  template<typename WorkerResource>
+  std::vector<GroceryItem> parse_in_chunks( std::string_view buffer, std::size_t threads, std::size_t chunkSize, std::pmr::memory_resource * resource, WorkerResource worker_resource )
+  {
+    chunkSize = std::max<std::size_t>( chunkSize, 1 );
+    if( threads <= 1 || buffer.size() <= chunkSize )
+    {
+      Chunk whole;
+      whole.bound = buffer.size();
+      parse_chunk( buffer, whole, resource );
+      return std::move( whole.items );
+    }
+
+    // Divide the buffer into chunks, each starting where a record appears to start.  The first chunk starts at the beginning, so it
+    // is always right.
+    std::vector<Chunk> chunks( ( buffer.size() + chunkSize - 1 ) / chunkSize );
+    for( std::size_t i = 1; i < chunks.size(); ++i )
+    {
+      chunks[i    ].start = std::max( resynchronize( buffer, i * chunkSize ), chunks[i - 1].start );
+      chunks[i - 1].bound = chunks[i].start;
+    }
+    chunks.back().bound = buffer.size();
+
+
+    // Parse the chunks on a pool of workers, each taking the next unclaimed chunk until none remain
+    {
+      std::atomic<std::size_t> nextChunk = 0;
+      std::exception_ptr       failure;
+      std::mutex               failureMutex;
+      std::vector<std::jthread> workers;
+
+      auto work = [&]
+      {
+        try
+        {
+          auto const workerResource = worker_resource();
+          for( auto i = nextChunk++;  i < chunks.size();  i = nextChunk++ ) parse_chunk( buffer, chunks[i], workerResource );
+        }
+        catch( ... )
+        {
+          std::scoped_lock lock( failureMutex );
+          if( !failure ) failure = std::current_exception();
+          nextChunk = chunks.size();                                          // stop the other workers early
+        }
+      };
+
+      for( auto n = std::min( threads, chunks.size() );  n > 0;  --n ) workers.emplace_back( work );
+      workers.clear();                                                        // jthreads join when destroyed
+
+      if( failure ) std::rethrow_exception( failure );
+    }
+
+
+    // Merge in order.  position is where the previous chunk actually stopped, which is where the next record really starts.  A chunk
+    // that guessed a different start is re-parsed from position, serially, before merging.
+    std::size_t total = 0;
+    for( auto & chunk : chunks ) total += chunk.items.size();
+
+    std::vector<GroceryItem> result;
+    result.reserve( total );
+
+    std::size_t position = 0;
+    for( auto & chunk : chunks )
+    {
+      if( chunk.start != position )
+      {
+        if( position >= chunk.bound ) continue;                               // the previous chunk's last record ran past all of this chunk
+        chunk.start = position;
+        parse_chunk( buffer, chunk, resource );
+      }
+
+      std::move( chunk.items.begin(), chunk.items.end(), std::back_inserter( result ) );
+      chunk.items = {};                                                       // release each chunk's memory as soon as it has been merged
+
+      position = chunk.end;
+      if( chunk.failed ) break;                                               // a malformed record ends the parse, just as it does serially
+    }
+
+    return result;
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Construction
+*******************************************************************************/
+
+GroceryItemParser::GroceryItemParser( std::string_view buffer, std::size_t offset ) noexcept
+  : _buffer( buffer ), _offset( std::min( offset, buffer.size() ) )
+{}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Parsing
+*******************************************************************************/
+
+// next()
+bool GroceryItemParser::next( GroceryItemRecord & record )
+{
+  // Work in a local record so a malformed record leaves the caller's record untouched, just like operator>>
+  GroceryItemRecord result;
+  if(    read_string( result.upcCode,     _scratch[0] ) && read_delimiter()
+      && read_string( result.brandName,   _scratch[1] ) && read_delimiter()
+      && read_string( result.productName, _scratch[2] ) && read_delimiter()
+      && read_price ( result.price                    ) )
+  {
+    record = result;
+    return true;
+  }
+  return false;
+}
+
+
+
+
+// offset()
+std::size_t GroceryItemParser::offset() const noexcept
+{
+  return _offset;
+}
+
+
+
+
+// skip_whitespace()
+void GroceryItemParser::skip_whitespace() noexcept
+{
+  _offset = find_non_space( _buffer, _offset );
+}
+
+
+
+
+// read_string()
+bool GroceryItemParser::read_string( std::string_view & field, std::string & scratch )
+{
+  skip_whitespace();
+  if( _offset >= _buffer.size() ) return false;
+
+  // std::quoted reads an unquoted field as a plain whitespace delimited word
+  if( _buffer[_offset] != '"' )
+  {
+    auto const begin = _offset;
+    while( _offset < _buffer.size() && !is_space( _buffer[_offset] ) ) ++_offset;
+    field = _buffer.substr( begin, _offset - begin );
+    return true;
+  }
+
+  // Quoted field.  In the common case there are no escapes and the field is a view of the buffer itself.
+  auto const begin = ++_offset;
+  auto       end   = find_quote_or_backslash( _buffer, begin );
+  if( end >= _buffer.size() ) { _offset = _buffer.size();  return false; }    // unterminated
+
+  if( _buffer[end] == '"' )
+  {
+    field   = _buffer.substr( begin, end - begin );
+    _offset = end + 1;
+    return true;
+  }
+
+  // Escapes present:  unescape into scratch storage, a run of ordinary characters at a time.  A backslash takes the next character
+  // literally.
+  scratch.clear();
+  for( auto from = begin;  end < _buffer.size();  end = find_quote_or_backslash( _buffer, from ) )
+  {
+    scratch.append( _buffer.data() + from, end - from );
+    if( _buffer[end] == '"' )
+    {
+      field   = scratch;
+      _offset = end + 1;
+      return true;
+    }
+
+    if( end + 1 >= _buffer.size() ) break;                                    // a backslash with nothing left to escape
+    scratch += _buffer[end + 1];
+    from = end + 2;
+  }
+
+  _offset = _buffer.size();
+  return false;                                                               // unterminated
+}
+
+
+
+
+// read_delimiter()
+bool GroceryItemParser::read_delimiter() noexcept
+{
+  skip_whitespace();
+  if( _offset >= _buffer.size() ) return false;
+  ++_offset;                                                                  // like operator>>( char ), any single non-whitespace character will do
+  return true;
+}
+
+
+
+
+// read_price()
+bool GroceryItemParser::read_price( Money & price ) noexcept
+{
+  skip_whitespace();
+
+  // Gather the same characters std::num_get would for a floating point number:  [sign] digits [. digits] [e [sign] digits]
+  auto const begin = _offset;
+  auto       i     = _offset;
+  auto       at    = [&]( std::size_t n ) { return n < _buffer.size() ? _buffer[n] : '\0'; };
+
+  if( at( i ) == '+' || at( i ) == '-' ) ++i;
+  while( is_digit( at( i ) ) ) ++i;
+  if( at( i ) == '.' ) for( ++i; is_digit( at( i ) ); ++i ) /* intentionally empty */;
+  if( at( i ) == 'e' || at( i ) == 'E' )
+  {
+    ++i;
+    if( at( i ) == '+' || at( i ) == '-' ) ++i;
+    while( is_digit( at( i ) ) ) ++i;
+  }
+
+  // from_chars() accepts a leading minus but not a leading plus, and everything gathered must convert (Ex:  "1e" does not)
+  auto first = _buffer.data() + begin;
+  auto last  = _buffer.data() + i;
+  if( first != last && *first == '+' ) ++first;
+
+  double value  = 0.0;
+  auto   result = std::from_chars( first, last, value );
+  if( first == last || result.ec != std::errc{} || result.ptr != last ) return false;
+
+  price   = Money( value );                                                   // rounded to the cent from the same double operator>> reads
+  _offset = i;
+  return true;
+}
+
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Non-member functions
+*******************************************************************************/
+
+// parse_grocery_items()
+std::vector<GroceryItem> parse_grocery_items( std::string_view buffer, std::size_t threads, std::size_t chunkSize, std::pmr::memory_resource * resource )
+{
+  return parse_in_chunks( buffer, threads, chunkSize, resource, [resource] { return resource; } );
+}
+
+
+
+
+// parse_grocery_items()    (into an arena)
+std::vector<GroceryItem> parse_grocery_items( std::string_view buffer, std::size_t threads, std::size_t chunkSize, MonotonicArena & arena )
+{
+  // Each worker allocates through its own front end to the arena, so the workers don't queue on the arena's lock for every string
+  return parse_in_chunks( buffer, threads, chunkSize, &arena, [&arena] { return arena.worker(); } );
+}
+
+
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Streaming
+*******************************************************************************/
+
+// Construct from a file name
+GroceryItemScanner::GroceryItemScanner( std::string const & filename, std::size_t threads, std::size_t chunkSize )
+  : _file( filename ), _threads( std::max<std::size_t>( threads, 1 ) ), _chunkSize( std::max<std::size_t>( chunkSize, 1 ) )
+{}
+
+
+
+
+// is_open()
+bool GroceryItemScanner::is_open() const noexcept
+{
+  return _file.is_open();
+}
+
+
+
+
+// failed()
+bool GroceryItemScanner::failed() const noexcept
+{
+  return _failed;
+}
+
+
+
+
+// next_batch()
+std::span<GroceryItemRecord const> GroceryItemScanner::next_batch()
+{
+  auto const buffer = _file.bytes();
+
+  while( !_done )
+  {
+    if( _next == _window.size() )
+    {
+      if( _position >= buffer.size() ) break;
+      refill();
+    }
+
+    // A batch that guessed a different start than where the previous batch actually stopped is re-parsed from there, just as
+    // parse_grocery_items() does when merging
+    auto & batch = _window[_next++];
+    if( batch.start != _position )
+    {
+      if( _position >= batch.bound ) continue;                                // the previous batch's last record ran past all of this one
+      batch.start = _position;
+      parse( batch );
+    }
+
+    _position = batch.end;
+    if( batch.failed ) _failed = _done = true;
+
+    _file.release_before( batch.start );                                      // every earlier batch has been handed out and is no longer valid
+    if( !batch.records.empty() ) return batch.records;
+  }
+
+  _done = true;
+  return {};
+}
+
+
+
+
+// parse()
+void GroceryItemScanner::parse( Batch & batch ) const
+{
+  auto const buffer = _file.bytes();
+  auto const inside = [&]( std::string_view field )                           // true if field is a view of the file rather than of the parser's scratch storage
+  {
+    return std::less_equal<char const *>{}( buffer.data(), field.data() ) && std::less<char const *>{}( field.data(), buffer.data() + buffer.size() );
+  };
+
+  batch.records  .clear();
+  batch.unescaped.clear();
+  batch.failed = false;
+
+  GroceryItemParser parser( buffer, batch.start );
+  for( parser.skip_whitespace();  parser.offset() < batch.bound;  parser.skip_whitespace() )
+  {
+    GroceryItemRecord record;
+    auto const        recordStart = parser.offset();
+    if( !parser.next( record ) )
+    {
+      batch.failed = true;
+      batch.end    = recordStart;
+      return;
+    }
+
+    // The parser reuses its scratch storage for the next record, so escaped fields must be kept elsewhere for the batch's lifetime
+    for( auto field : { &record.upcCode, &record.brandName, &record.productName } )
+    {
+      if( !field->empty() && !inside( *field ) ) *field = batch.unescaped.emplace_back( *field );
+    }
+    batch.records.push_back( record );
+  }
+  batch.end = parser.offset();
+}
+
+
+
+
+// refill()
+void GroceryItemScanner::refill()
+{
+  auto const buffer = _file.bytes();
+
+  // Split the next threads * chunkSize bytes into chunks, each starting where a record appears to start.  The first starts where
+  // the previous window actually stopped, so it is always right.
+  _window.resize( _threads );
+  _next = 0;
+
+  _window.front().start = _position;
+  for( std::size_t i = 1; i < _window.size(); ++i )
+  {
+    _window[i    ].start = std::max( resynchronize( buffer, _position + i * _chunkSize ), _window[i - 1].start );
+    _window[i - 1].bound = _window[i].start;
+  }
+  _window.back().bound = std::max( resynchronize( buffer, _position + _window.size() * _chunkSize ), _window.back().start );
+
+  if( _window.size() == 1 )
+  {
+    parse( _window.front() );
+    return;
+  }
+
+  std::exception_ptr        failure;
+  std::mutex                failureMutex;
+  std::vector<std::jthread> workers;
+
+  auto work = [&]( Batch & batch )
+  {
+    try
+    {
+      parse( batch );
+    }
+    catch( ... )
+    {
+      std::scoped_lock lock( failureMutex );
+      if( !failure ) failure = std::current_exception();
+    }
+  };
+
+  for( std::size_t i = 1; i < _window.size(); ++i ) workers.emplace_back( work, std::ref( _window[i] ) );
+  work( _window.front() );                                                    // the calling thread takes the first chunk
+  workers.clear();                                                            // jthreads join when destroyed
+
+  if( failure ) std::rethrow_exception( failure );
+}
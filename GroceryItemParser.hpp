@@ -0,0 +1,142 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <deque>
+#include <memory_resource>                                                    // memory_resource, get_default_resource()
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "MappedFile.hpp"
+#include "MonotonicArena.hpp"
+#include "Money.hpp"
+
+
+
+
+// One grocery item record as it appears in a grocery item database file.  The string fields refer either to the parsed buffer
+// itself or, only when the field contained backslash escapes, to the parser's scratch storage.  Either way they remain valid only
+// until the parser reads the next record, and the buffer must outlive them.
+struct GroceryItemRecord
+{
+  std::string_view upcCode;
+  std::string_view brandName;
+  std::string_view productName;
+  Money            price;
+};
+
+
+
+
+// Parses grocery item records directly out of a contiguous buffer of bytes, typically a memory mapped database file, with the same
+// grammar operator>>( std::istream &, GroceryItem & ) accepts:
+//
+//     "UPC Code" , "Brand Name" , "Product Name" , Price
+//
+// Strings are enclosed in double quotes with embedded quotes and backslashes escaped by a backslash, each delimiter is a single
+// character (conventionally a comma), and any amount of whitespace, newlines included, may surround the fields.  Nothing is
+// allocated and no locale is consulted unless a field actually contains an escape.  Quoted fields and runs of whitespace are scanned
+// a SIMD vector of bytes at a time, and prices are converted with std::from_chars() and rounded to the cent (see class Money).
+class GroceryItemParser
+{
+  public:
+    explicit GroceryItemParser( std::string_view buffer, std::size_t offset = 0 ) noexcept;   // start parsing offset bytes into buffer
+
+    bool        next           ( GroceryItemRecord & record );                // parse the next record, returns false at the end of the buffer or at a malformed record
+    void        skip_whitespace() noexcept;                                   // advance to the next record's first character, or to the end of the buffer
+    std::size_t offset         () const noexcept;                             // number of bytes consumed so far
+
+  private:
+    bool read_string    ( std::string_view & field, std::string & scratch );
+    bool read_delimiter ()                                      noexcept;
+    bool read_price     ( Money & price )                       noexcept;
+
+    std::string_view _buffer;
+    std::size_t      _offset = 0;
+    std::string      _scratch[3];                                             // unescaped copies of the UPC, brand, and product fields, used only when needed
+};
+
+
+
+
+// Parse every grocery item in buffer, stopping at the end of the buffer or at the first malformed record, exactly as repeatedly
+// calling GroceryItemParser::next() (or operator>>) would.  With more than one thread the buffer is split into chunks of about
+// chunkSize bytes, each chunk is resynchronized to the first line that looks like the start of a record and parsed on a pool of
+// worker threads, and the chunks are merged in file order.  A chunk whose guessed start turns out not to be where the previous
+// chunk actually ended (a line inside a multi-line record can look like the start of one) is discarded and re-parsed from the
+// right place, so the result never depends on the number of threads or the chunk size.
+//
+// The grocery items' strings are allocated from resource, which must outlive them and, with more than one thread, must be safe to
+// use from several threads at once (the default resource is;  a std::pmr::monotonic_buffer_resource is not, see MonotonicArena).
+// Parsed into a MonotonicArena, each worker allocates through a worker() of its own, so the workers don't contend for the arena.
+std::vector<GroceryItem> parse_grocery_items( std::string_view            buffer,
+                                              std::size_t                 threads   = 1,
+                                              std::size_t                 chunkSize = std::size_t{ 1 } << 20,
+                                              std::pmr::memory_resource * resource  = std::pmr::get_default_resource() );
+
+std::vector<GroceryItem> parse_grocery_items( std::string_view buffer, std::size_t threads, std::size_t chunkSize, MonotonicArena & arena );
+
+
+
+
+// Streams the grocery item records of a database file a batch at a time, for one pass jobs (Ex: price audits, brand reports) that
+// don't need the whole catalog in memory.  Records are parsed by GroceryItemParser, with the same grammar and the same stopping rule
+// as parse_grocery_items(), and are never turned into GroceryItems, so nothing is allocated per record.
+//
+// A batch is the records that start within one chunk of about chunkSize bytes of the file.  With more than one thread, the next
+// threads chunks are parsed concurrently, resynchronized and (when a guess was wrong) re-parsed exactly as parse_grocery_items()
+// does, and then handed out in file order.  Memory is bounded by the chunks in flight:  the file's pages are released once the scan
+// has moved past them.
+class GroceryItemScanner
+{
+  public:
+    explicit GroceryItemScanner( std::string const & filename, std::size_t threads = 1, std::size_t chunkSize = std::size_t{ 1 } << 20 );
+
+    bool                               is_open   () const noexcept;           // false if the file couldn't be opened, and then there are no records
+    std::span<GroceryItemRecord const> next_batch();                          // the next batch, empty once the scan is over.  Valid until the next call
+    bool                               failed    () const noexcept;           // true if the scan stopped at a malformed record rather than the end of the file
+
+  private:
+    struct Batch
+    {
+      std::size_t                    start  = 0;
+      std::size_t                    bound  = 0;
+      std::size_t                    end    = 0;
+      bool                           failed = false;
+      std::vector<GroceryItemRecord> records;
+      std::deque<std::string>        unescaped;                               // fields that contained escapes, moved out of the parser's scratch storage
+    };
+
+    void parse ( Batch & batch ) const;                                       // parse the records starting in [batch.start, batch.bound)
+    void refill();                                                            // parse the next window of batches, beginning at _position
+
+    MappedFile         _file;
+    std::size_t        _threads;
+    std::size_t        _chunkSize;
+    std::vector<Batch> _window;                                               // batches parsed ahead, handed out in order
+    std::size_t        _next     = 0;                                         // the next batch in _window to hand out
+    std::size_t        _position = 0;                                         // where the next record really starts
+    bool               _failed   = false;
+    bool               _done     = false;
+};
+
+
+
+
+// Call callback( GroceryItemRecord const & ) for every record in filename, in order, scanning with a GroceryItemScanner.  Returns
+// the number of records.
+template<typename Callback>
+std::size_t for_each_grocery_item( std::string const & filename, Callback && callback, std::size_t threads = 1 )
+{
+  GroceryItemScanner scanner( filename, threads );
+  std::size_t        count = 0;
+
+  for( auto batch = scanner.next_batch();  !batch.empty();  batch = scanner.next_batch() )
+  {
+    for( auto const & record : batch ) callback( record );
+    count += batch.size();
+  }
+  return count;
+}
@@ -0,0 +1,293 @@
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <filesystem>                                                                       // temp_directory_path(), remove()
+#include <fstream>                                                                          // ofstream
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <random>                                                                           // mt19937_64, uniform_int_distribution
+#include <memory_resource>                                                                  // pmr::vector, get_default_resource()
+#include <sstream>                                                                          // istringstream
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>                                                                          // move(), pair
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+#include "MappedFile.hpp"
+#include "MonotonicArena.hpp"
+
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemParserRegressionTest
+  {
+    public:
+      GroceryItemParserRegressionTest();
+
+    private:
+      void parallelMatchesSerial();
+      void recordsMatchExtractor();
+      void arenaAllocation();
+      void streaming();
+
+      Regression::CheckResults affirm;
+  } run_groceryItemParser_tests;
+
+
+
+
+  // The reference:  read grocery items one after another with operator>> until it fails
+  std::vector<GroceryItem> extract_all( std::string_view text )
+  {
+    std::istringstream       stream{ std::string( text ) };
+    std::vector<GroceryItem> items;
+    for( GroceryItem item; stream >> item; ) items.push_back( std::move( item ) );
+    return items;
+  }
+
+
+
+
+  // Identical means the same items in the same order with bit-for-bit identical prices, not just prices within epsilon
+  bool identical( std::vector<GroceryItem> const & lhs, std::vector<GroceryItem> const & rhs )
+  {
+    if( lhs.size() != rhs.size() ) return false;
+    for( std::size_t i = 0; i < lhs.size(); ++i ) if( !( lhs[i] == rhs[i] ) || lhs[i].price() != rhs[i].price() ) return false;
+    return true;
+  }
+
+
+
+
+  void GroceryItemParserRegressionTest::parallelMatchesSerial()
+  {
+    // Fields that look like the start of a record (a quoted number first on a line) are planted to trip up resynchronization, along
+    // with escapes, unusual spacing, and malformed records that must end the parse early.
+    std::string const adversarial = R"~~("00072250018548","Nature's Own","Nature's Own Butter Buns Hotdog - 8 Ct",10.79
+
+"00028000517205",
+"12345",
+"67890"   ,
+17.97
+"00034000020706"    ,  "York", "York \"42\"
+Peppermint Patties", 12.64 "00038000570742",
+    "Kellogg's", "Kellogg's \"Krave\" Chocolate \\ Cereal",
+  18.66
+
+"00014100072331" , "Pepperidge Farm", "Pepperidge Farm
+          Classic Cookie Favorites", 14.43
+"833735000720","Quorn","Quorn Spaghetti & Meatless Meatballs",+23.32
+"12844098150","Refresh Your Car!","Refresh Your Car! Odor Eliminating Scented Oil Wick",9.79e0
+)~~";
+
+    std::string tail = adversarial;
+    for( int i = 0; i < 50; ++i ) tail += adversarial;                                          // long enough to span many chunks
+    std::string const malformed = tail + "\"00000000000000\", \"invalid item\" \"invalid 7.99\n" + adversarial;
+    std::string const truncated = tail + "\"00000000000000\", \"incomplete / invalid grocery item\"";
+
+    std::vector<std::pair<char const *, std::string>> inputs = { { "adversarial", tail      },
+                                                                 { "malformed",   malformed },
+                                                                 { "truncated",   truncated },
+                                                                 { "empty",       ""        },
+                                                                 { "blank",       "  \n\n " } };
+
+    MappedFile file( "Grocery_UPC_Database-Small.dat" );
+    if( file.is_open() ) inputs.emplace_back( "Grocery_UPC_Database-Small.dat", std::string( file.bytes() ) );
+
+    for( auto const & [name, text] : inputs )
+    {
+      auto const expected = extract_all( text );
+      bool       allMatch = true;
+
+      for( std::size_t threads : { 1, 2, 3, 8 } )
+      {
+        for( std::size_t chunkSize : { 1, 7, 64, 4096, 1 << 20 } )
+        {
+          allMatch = identical( expected, parse_grocery_items( text, threads, chunkSize ) ) && allMatch;
+        }
+      }
+      affirm.is_true( std::string( "Parallel parse matches operator>> - " ) + name, allMatch );
+    }
+  }
+
+
+
+  // Record by record agreement with operator>>, including on malformed input, with fields long enough to span several SIMD blocks
+  // and escapes and whitespace placed at every offset within a block.  Randomly mutated records probe the corners.
+  void GroceryItemParserRegressionTest::recordsMatchExtractor()
+  {
+    std::string const longField = std::string( 40, 'a' ) + "\\\"" + std::string( 29, 'b' ) + "\\\\" + std::string( 70, 'c' ) + "\\x";
+    std::vector<std::string> const records = { R"("00072250018548","Nature's Own","Nature's Own Butter Buns Hotdog - 8 Ct",10.79)",
+                                               R"(   "00028000517205"   ,   "Nestle"                                            ,)" "\n\t\r\v\f" R"(  "Nestle Media Crema Table Cream",  17.97  )",
+                                               "\"0001\", \"" + longField + "\", \"" + longField + longField + "\", -0.5e1",
+                                               R"(unquoted , "word", "fields",1.)",
+                                               R"("1","2","3",.5 "4","5","6",1e400)" };
+
+    auto matches = [&]( std::string const & text )
+    {
+      for( std::size_t chunkSize : { 3, 1 << 20 } )
+      {
+        if( !identical( extract_all( text ), parse_grocery_items( text, chunkSize == 3 ? 2 : 1, chunkSize ) ) ) return false;
+      }
+      return true;
+    };
+
+    bool allMatch = true;
+    for( auto const & record : records )
+    {
+      for( std::size_t length = 0; length <= record.size(); ++length ) allMatch = matches( record.substr( 0, length ) ) && allMatch;   // every truncation
+      for( std::size_t pad = 0; pad < 40; ++pad ) allMatch = matches( std::string( pad, ' ' ) + record + '\n' + record ) && allMatch;     // every alignment
+    }
+    affirm.is_true( "Records match operator>> - truncated and shifted   ", allMatch );
+
+    std::mt19937_64                            random( 20'241'016 );
+    std::string const                          alphabet = "\"\\, \n\t01.e+-xE";
+    std::uniform_int_distribution<std::size_t> pick;
+
+    allMatch = true;
+    for( int trial = 0; trial < 5'000; ++trial )
+    {
+      auto text = records[pick( random ) % records.size()] + '\n' + records[pick( random ) % records.size()];
+      for( auto mutations = pick( random ) % 4 + 1; mutations > 0; --mutations )
+      {
+        auto const position = pick( random ) % ( text.size() + 1 );
+        switch( pick( random ) % 3 )
+        {
+          case 0:  text.insert( position, 1, alphabet[pick( random ) % alphabet.size()] );        break;
+          case 1:  if( position < text.size() ) text.erase( position, 1 );                           break;
+          default: if( position < text.size() ) text[position] = alphabet[pick( random ) % alphabet.size()];
+        }
+      }
+      allMatch = matches( text ) && allMatch;
+    }
+    affirm.is_true( "Records match operator>> - randomly mutated        ", allMatch );
+  }
+
+
+
+  void GroceryItemParserRegressionTest::arenaAllocation()
+  {
+    MappedFile     file( "Grocery_UPC_Database-Small.dat" );
+    auto const     expected = parse_grocery_items( file.bytes() );
+    MonotonicArena arena;
+
+    for( std::size_t threads : { 1, 3 } )
+    {
+      auto const items = parse_grocery_items( file.bytes(), threads, 64, arena );
+
+      bool inArena = true;
+      for( auto const & item : items ) inArena = inArena && *item.get_allocator().resource() == arena;   // the arena, or one of its workers
+      affirm.is_true( "Arena parse matches default parse - " + std::to_string( threads ) + " thread(s)   ", identical( expected, items ) );
+      affirm.is_true( "Arena parse allocates from the arena - " + std::to_string( threads ) + " thread(s)", inArena && arena.bytes_allocated() > 0 );
+    }
+
+    {  // Copies leave the arena, allocator-aware containers pass theirs along
+      std::pmr::vector<GroceryItem> items( &arena );
+      items.emplace_back( "grocery item's product name", "grocery item's brand name", "grocery item's UPC code", 123.79 );
+      GroceryItem copy( items.back() );
+
+      affirm.is_true( "Allocator-aware container construction            ", items.back().get_allocator().resource() == &arena );
+      affirm.is_true( "Copy uses the default resource                    ", copy.get_allocator().resource() == std::pmr::get_default_resource() && copy == items.back() );
+    }
+
+    {  // Workers share the arena's memory, so an item moved between them keeps its strings
+      auto       worker = arena.worker();
+      GroceryItem fromWorker( "grocery item's product name, too long to fit inside the string", "brand", "upc", 1.00, worker );
+      GroceryItem inArena   ( {}, {}, {}, 0.0, &arena );
+      auto const  before    = fromWorker.productName().data();
+      inArena = std::move( fromWorker );
+
+      affirm.is_true( "Arena workers compare equal to the arena          ", *worker == arena && *arena.worker() == *worker && !( *worker == *std::pmr::get_default_resource() ) );
+      affirm.is_true( "Move between arena workers keeps the strings      ", inArena.productName().data() == before );
+    }
+  }
+
+
+
+  // Scanning a file batch by batch yields exactly the items operator>> extracts, in order, whatever the batch size and however many
+  // threads parse ahead, and stops at the same malformed record
+  void GroceryItemParserRegressionTest::streaming()
+  {
+    std::string const record    = R"~~("00034000020706"    ,  "York", "York \"42\"
+Peppermint Patties", 12.64 "00038000570742", "Kellogg's", "Kellogg's \"Krave\" Chocolate \\ Cereal",  18.66
+"12345",
+"67890"   ,
+"00028000517205", 17.97
+)~~";
+    std::string       wellFormed;
+    for( int i = 0; i < 40; ++i ) wellFormed += record;
+    std::string const malformed = wellFormed + "\"00000000000000\", \"no product name\", 7.99\n" + record;
+
+    std::vector<std::tuple<char const *, std::string, bool>> inputs = { { "well formed", wellFormed, false },     // name, text, ends with a malformed record
+                                                                        { "malformed",   malformed,  true  },
+                                                                        { "empty",       "",         false } };
+
+    MappedFile file( "Grocery_UPC_Database-Small.dat" );
+    if( file.is_open() ) inputs.emplace_back( "Grocery_UPC_Database-Small.dat", std::string( file.bytes() ), true );
+
+    auto const path = ( std::filesystem::temp_directory_path() / "GroceryItemParserTests.dat" ).string();
+    for( auto const & [name, text, endsMalformed] : inputs )
+    {
+      std::ofstream( path, std::ios::binary | std::ios::trunc ) << text;
+
+      auto const expected = extract_all( text );
+      bool       allMatch = true;
+      bool       stopped  = true;
+
+      for( std::size_t threads : { 1, 3 } )
+      {
+        for( std::size_t chunkSize : { 7, 64, 4096 } )
+        {
+          GroceryItemScanner       scanner( path, threads, chunkSize );
+          std::vector<GroceryItem> items;
+          for( auto batch = scanner.next_batch();  !batch.empty();  batch = scanner.next_batch() )
+          {
+            for( auto const & item : batch ) items.emplace_back( item.productName, item.brandName, item.upcCode, item.price );
+          }
+          allMatch = identical( expected, items ) && allMatch;
+          stopped  = scanner.failed() == endsMalformed && stopped;
+        }
+      }
+
+      std::size_t count = for_each_grocery_item( path, []( GroceryItemRecord const & ) {} );
+      affirm.is_true( std::string( "Streaming scan matches operator>> - " ) + name, allMatch && stopped && count == expected.size() );
+    }
+    std::filesystem::remove( path );
+  }
+
+
+
+  GroceryItemParserRegressionTest::GroceryItemParserRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Parser Regression Test:  Parallel vs. serial\n";
+      parallelMatchesSerial();
+
+      std::clog << "\nGroceryItem Parser Regression Test:  Record by record vs. operator>>\n";
+      recordsMatchExtractor();
+
+      std::clog << "\nGroceryItem Parser Regression Test:  Arena allocation\n";
+      arenaAllocation();
+
+      std::clog << "\nGroceryItem Parser Regression Test:  Streaming scan\n";
+      streaming();
+
+      std::clog << "\n\nGroceryItem Parser Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"GroceryItemParser\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
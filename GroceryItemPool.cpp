@@ -0,0 +1,77 @@
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t
+#include <limits>                                                             // numeric_limits
+#include <stdexcept>                                                          // length_error
+#include <type_traits>                                                        // is_trivially_copyable_v
+#include <utility>                                                            // move()
+
+#include "GroceryItem.hpp"
+#include "GroceryItemPool.hpp"
+
+
+
+static_assert( std::is_trivially_copyable_v<GroceryItemPool::Handle> && sizeof( GroceryItemPool::Handle ) == sizeof( std::uint32_t ), "a handle must cost no more than an integer to copy" );
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// add()
+GroceryItemPool::Handle GroceryItemPool::add( GroceryItem groceryItem )
+{
+  if( _items.size() > std::numeric_limits<std::uint32_t>::max() ) throw std::length_error( "Error - Length error:  too many grocery items for 32-bit handles" );
+
+  _items.push_back( std::move( groceryItem ) );
+  return Handle( static_cast<std::uint32_t>( _items.size() - 1 ) );
+}
+
+
+
+
+// reserve()
+void GroceryItemPool::reserve( std::size_t count )
+{
+  _items.reserve( count );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// operator[] const
+GroceryItem const & GroceryItemPool::operator[]( Handle handle ) const noexcept
+{
+  return _items[handle._index];
+}
+
+
+
+
+// operator[]
+GroceryItem & GroceryItemPool::operator[]( Handle handle ) noexcept
+{
+  return _items[handle._index];
+}
+
+
+
+
+// size()
+std::size_t GroceryItemPool::size() const noexcept
+{
+  return _items.size();
+}
@@ -0,0 +1,59 @@
+#pragma once                                                                  // include guard
+
+#include <compare>                                                            // strong_ordering
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t
+#include <queue>
+#include <stack>
+#include <vector>
+
+#include "GroceryItem.hpp"
+
+
+
+
+// Where the grocery items a shopper picks live while they're moved from cart to cart, so the carts themselves hold only handles.  An
+// item is moved into the pool once, when it is picked, and never copied again:  pushing it onto a cart, moving it to another cart,
+// or setting it on the checkout counter copies a 32-bit handle instead of three strings.
+//
+// Handles stay valid, and keep naming the same item, for the life of the pool.  Items are never removed, the pool is simply
+// discarded when the shopping is done.
+class GroceryItemPool
+{
+  public:
+    // Names one item in the pool.  As cheap to copy as the integer it is.
+    class Handle
+    {
+      friend class GroceryItemPool;
+
+      public:
+        std::uint32_t index() const noexcept { return _index; }               // the item's position in the pool, in the order picked
+
+        constexpr auto operator<=>( Handle const & ) const noexcept = default;
+
+      private:
+        explicit Handle( std::uint32_t index ) noexcept : _index( index ) {}
+
+        std::uint32_t _index;
+    };
+
+    // Modifiers
+    Handle add    ( GroceryItem groceryItem );                                // take ownership of groceryItem, moved if given an r-value.  Throws
+                                                                              // std::length_error past 2^32 items
+    void   reserve( std::size_t count );
+
+    // Queries
+    GroceryItem const & operator[]( Handle handle ) const noexcept;
+    GroceryItem       & operator[]( Handle handle )       noexcept;
+    std::size_t         size      ()                const noexcept;
+
+  private:
+    std::vector<GroceryItem> _items;
+};
+
+
+
+// Carts and checkout lanes of handles into a GroceryItemPool.  A cart keeps its handles in a vector, which (unlike the default
+// deque) keeps its memory as the cart empties, so items going on and off a cart allocate nothing once the cart has been full.
+using GroceryCart  = std::stack<GroceryItemPool::Handle, std::vector<GroceryItemPool::Handle>>;
+using CheckoutLane = std::queue<GroceryItemPool::Handle>;
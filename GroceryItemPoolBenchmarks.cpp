@@ -0,0 +1,130 @@
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iostream>                                                                         // clog
+#include <queue>
+#include <stack>
+#include <string>
+#include <type_traits>                                                                      // decay_t
+#include <utility>                                                                          // move()
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "CompactGroceryItem.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+#include "GroceryItemPool.hpp"
+#include "MappedFile.hpp"
+#include "MonotonicArena.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemPoolBenchmark
+  {
+    public:
+      GroceryItemPoolBenchmark();
+
+    private:
+      void carts( std::string const & filename );
+  } run_groceryItemPool_benchmarks;
+
+
+
+
+  // A million items, the catalog's repeated as needed, pushed onto a cart, moved to another cart one at a time (as the carefully
+  // moving algorithm does), unloaded onto a checkout lane, and copied whole (as trace() does after every move).  Carts of grocery
+  // items, of compact grocery items, and of handles into a pool.
+  void GroceryItemPoolBenchmark::carts( std::string const & filename )
+  {
+    constexpr std::size_t ITEMS = 1'000'000;
+
+    MappedFile               file( filename );
+    std::vector<GroceryItem> catalog = parse_grocery_items( file.bytes() );
+    if( catalog.empty() ) return;
+
+    std::vector<GroceryItem> items;
+    items.reserve( ITEMS );
+    for( std::size_t i = 0; i < ITEMS; ++i ) items.push_back( catalog[i % catalog.size()] );
+
+    MonotonicArena                  arena;
+    std::vector<CompactGroceryItem> compact;
+    compact.reserve( ITEMS );
+    for( auto const & item : items ) compact.emplace_back( item, &arena );
+
+    GroceryItemPool                      pool;
+    std::vector<GroceryItemPool::Handle> handles;
+    pool.reserve( ITEMS );
+    handles.reserve( ITEMS );
+    for( auto const & item : items ) handles.push_back( pool.add( item ) );
+
+    std::clog << "\n" << filename << ":  " << ITEMS << " items, " << catalog.size() << " distinct\n";
+
+    auto measure = [&]( std::string const & kind, auto const & source )
+    {
+      using Cart = std::stack<typename std::decay_t<decltype( source )>::value_type>;
+      using Lane = std::queue<typename std::decay_t<decltype( source )>::value_type>;
+
+      Cart loaded;
+      auto seconds = Benchmark::seconds( [&]
+      {
+        Cart cart;
+        for( auto const & item : source ) cart.push( item );
+        Benchmark::do_not_optimize( cart.size() );
+        loaded = std::move( cart );
+      }, 3 );
+      Benchmark::report( "load a cart - " + kind, ITEMS, seconds );
+
+      // There and back again, so every repetition starts from the same loaded cart without copying it.  First copying each item
+      // (as main() used to) and then moving it.
+      seconds = Benchmark::seconds( [&]
+      {
+        Cart other;
+        for( ; !loaded.empty(); loaded.pop() ) other .push( loaded.top() );
+        for( ; !other .empty(); other .pop() ) loaded.push( other .top() );
+      }, 3 );
+      Benchmark::report( "cart to cart, copied - " + kind, 2 * ITEMS, seconds );
+
+      seconds = Benchmark::seconds( [&]
+      {
+        Cart other;
+        for( ; !loaded.empty(); loaded.pop() ) other .push( std::move( loaded.top() ) );
+        for( ; !other .empty(); other .pop() ) loaded.push( std::move( other .top() ) );
+      }, 3 );
+      Benchmark::report( "cart to cart, moved - " + kind, 2 * ITEMS, seconds );
+
+      seconds = Benchmark::seconds( [&]
+      {
+        Lane lane;
+        for( ; !loaded.empty(); loaded.pop() ) lane  .push( std::move( loaded.top()   ) );
+        for( ; !lane  .empty(); lane  .pop() ) loaded.push( std::move( lane  .front() ) );
+      }, 3 );
+      Benchmark::report( "cart to checkout lane and back - " + kind, 2 * ITEMS, seconds );
+
+      seconds = Benchmark::seconds( [&] { auto snapshot = loaded;  Benchmark::do_not_optimize( snapshot.size() ); }, 3 );
+      Benchmark::report( "copy a whole cart - " + kind, ITEMS, seconds );
+    };
+
+    measure( "GroceryItem",        items   );
+    measure( "CompactGroceryItem", compact );
+    measure( "handle",             handles );
+  }
+
+
+
+
+  GroceryItemPoolBenchmark::GroceryItemPoolBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nGroceryItemPool Benchmarks:  Carts of items vs. carts of handles\n";
+      for( auto const & filename : Benchmark::database_files() ) carts( filename );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"class GroceryItemPool\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,86 @@
+#include <exception>
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <string>
+#include <utility>                                                                          // move()
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemPool.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemPoolRegressionTest
+  {
+    public:
+      GroceryItemPoolRegressionTest();
+
+    private:
+      void tests();
+
+      Regression::CheckResults affirm;
+  } run_groceryItemPool_tests;
+
+
+
+
+  void GroceryItemPoolRegressionTest::tests()
+  {
+    GroceryItemPool pool;
+    GroceryItem     milk( "milk", "any", "00075457129000", 30.28 );
+    std::string     longName( 60, 'x' );                                                    // too long for the string's own buffer
+
+    auto const eggs      = pool.add( GroceryItem( "eggs", "any", "00688267039317", 77.47 ) );
+    auto const copied    = pool.add( milk );
+    auto const moved     = pool.add( GroceryItem( longName, "any", "00835841005255", 8.73 ) );
+
+    affirm.is_equal( "Pool - size                                      ", std::size_t{ 3 }, pool.size() );
+    affirm.is_true ( "Pool - handles are distinct, in the order added  ", eggs < copied && copied < moved && eggs.index() == 0 && moved.index() == 2 );
+    affirm.is_equal( "Pool - handle names its item                     ", GroceryItem( "eggs", "any", "00688267039317", 77.47 ), pool[eggs] );
+    affirm.is_equal( "Pool - adding an l-value copies it               ", milk, pool[copied] );
+    affirm.is_equal( "Pool - adding an r-value moves it                ", longName, std::string( pool[moved].productName() ) );
+
+    pool[copied].price( 9.64 );
+    affirm.is_equal( "Pool - items are modifiable through handles      ", 9.64, pool[copied].price() );
+
+    // Carts and lanes carry handles, the items stay where they are
+    auto const * address = &pool[eggs];
+    GroceryCart  broken, working;
+    for( auto handle : { eggs, copied, moved } ) broken.push( handle );
+    for( ; !broken.empty(); broken.pop() ) working.push( broken.top() );
+
+    CheckoutLane lane;
+    for( ; !working.empty(); working.pop() ) lane.push( working.top() );
+
+    std::vector<GroceryItemPool::Handle> order;
+    for( ; !lane.empty(); lane.pop() ) order.push_back( lane.front() );
+    affirm.is_true( "Pool - carts and lanes keep the handles' order   ", order == std::vector<GroceryItemPool::Handle>{ eggs, copied, moved } );
+    affirm.is_true( "Pool - items never move                          ", address == &pool[eggs] );
+  }
+
+
+
+
+  GroceryItemPoolRegressionTest::GroceryItemPoolRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nGroceryItemPool Regression Test:\n";
+      tests();
+
+      std::clog << "\n\nGroceryItemPool Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class GroceryItemPool\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,262 @@
+#include <algorithm>                                                          // sort(), unique(), lower_bound(), partial_sort(), min()
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t
+#include <limits>                                                             // numeric_limits
+#include <span>
+#include <stdexcept>                                                          // length_error
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryItemSearch.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  constexpr char SEPARATOR = '\0';                                            // between an item's product and brand names
+
+  char fold( char c ) noexcept
+  {
+    return 'A' <= c && c <= 'Z' ? static_cast<char>( c - 'A' + 'a' ) : c;
+  }
+
+
+
+  void append_folded( std::string & to, std::string_view text )
+  {
+    for( char c : text ) to.push_back( fold( c ) );
+  }
+
+
+
+  // The distinct grams of folded names, ascending:  every three byte window (trigram), packed into the low 24 bits, and with
+  // bigrams every two byte window too, packed into the low 16 bits with bit 24 set so they never collide with a trigram.  Windows
+  // spanning the separator belong to neither name and are skipped.
+  void distinct_grams( std::string_view names, bool bigrams, std::vector<std::uint32_t> & grams )
+  {
+    auto byte = [&]( std::size_t i ) { return std::uint32_t{ static_cast<unsigned char>( names[i] ) }; };
+
+    grams.clear();
+    for( std::size_t i = 0; i + 2 <= names.size(); ++i )
+    {
+      if( names[i] == SEPARATOR || names[i + 1] == SEPARATOR ) continue;
+      if( bigrams )                                            grams.push_back( 1U << 24 | byte( i ) << 8 | byte( i + 1 ) );
+      if( i + 3 <= names.size() && names[i + 2] != SEPARATOR ) grams.push_back( byte( i ) << 16 | byte( i + 1 ) << 8 | byte( i + 2 ) );
+    }
+    std::sort( grams.begin(), grams.end() );
+    grams.erase( std::unique( grams.begin(), grams.end() ), grams.end() );
+  }
+
+
+
+  bool is_word_character( char c ) noexcept
+  {
+    return ( 'a' <= c && c <= 'z' ) || ( '0' <= c && c <= '9' ) || static_cast<unsigned char>( c ) >= 0x80;
+  }
+
+
+
+  template<typename T>
+  std::size_t capacity_bytes( std::vector<T> const & v ) noexcept
+  {
+    return v.capacity() * sizeof( T );
+  }
+}    // namespace
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Construction
+*******************************************************************************/
+
+// Construct from grocery items
+GroceryItemSearch::GroceryItemSearch( std::span<GroceryItem const> items )
+  : _items( items )
+{
+  _nameOffsets.reserve( items.size() + 1 );
+  for( auto const & item : items )
+  {
+    append_folded( _names, item.productName() );
+    _names.push_back( SEPARATOR );
+    append_folded( _names, item.brandName() );
+
+    if( _names.size() > std::numeric_limits<std::uint32_t>::max() ) throw std::length_error( "Too many grocery item names to index" );
+    _nameOffsets.push_back( static_cast<std::uint32_t>( _names.size() ) );
+  }
+
+  // Two passes over the names:  count each gram's items to size the posting lists exactly, then fill them.  Items are visited in
+  // order, so each list comes out ascending without sorting.
+  std::unordered_map<std::uint32_t, std::uint32_t> next;                      // gram -> count, then -> where its next item goes
+  std::vector<std::uint32_t>                       grams;
+
+  for( ItemId item = 0; item < items.size(); ++item )
+  {
+    distinct_grams( names_of( item ), true, grams );
+    for( auto gram : grams ) ++next[gram];
+  }
+
+  _grams.reserve( next.size() );
+  for( auto const & [gram, count] : next ) _grams.push_back( gram );
+  std::sort( _grams.begin(), _grams.end() );
+
+  _postingOffsets.reserve( _grams.size() + 1 );
+  for( auto gram : _grams )
+  {
+    auto count = next[gram];
+    next[gram] = _postingOffsets.back();
+    _postingOffsets.push_back( _postingOffsets.back() + count );
+  }
+
+  _postings.resize( _postingOffsets.back() );
+  for( ItemId item = 0; item < items.size(); ++item )
+  {
+    distinct_grams( names_of( item ), true, grams );
+    for( auto gram : grams ) _postings[next[gram]++] = item;
+  }
+}
+
+
+
+
+// size()
+std::size_t GroceryItemSearch::size() const noexcept
+{
+  return _items.size();
+}
+
+
+
+
+// memory_bytes()
+std::size_t GroceryItemSearch::memory_bytes() const noexcept
+{
+  return _names.capacity() + capacity_bytes( _nameOffsets ) + capacity_bytes( _grams ) + capacity_bytes( _postingOffsets ) + capacity_bytes( _postings );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// find()
+std::vector<GroceryItem const *> GroceryItemSearch::find( std::string_view query, std::size_t k ) const
+{
+  if( query.empty() || k == 0 ) return {};
+
+  std::string folded;
+  append_folded( folded, query );
+
+  // (rank, product name length, item), so the best matches sort first
+  std::vector<std::tuple<std::size_t, std::size_t, ItemId>> matches;
+  for( auto item : candidates( folded ) )
+  {
+    auto names = names_of( item );
+    if( auto r = rank( names, folded ); r < 4 ) matches.emplace_back( r, names.find( SEPARATOR ), item );
+  }
+
+  k = std::min( k, matches.size() );
+  std::partial_sort( matches.begin(), matches.begin() + static_cast<std::ptrdiff_t>( k ), matches.end() );
+
+  std::vector<GroceryItem const *> result;
+  result.reserve( k );
+  for( std::size_t i = 0; i < k; ++i ) result.push_back( &_items[std::get<ItemId>( matches[i] )] );
+  return result;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private Helpers
+*******************************************************************************/
+
+// Every item that might contain folded:  those holding all of its trigrams (or its bigram, if it's two bytes long), or every item if
+// it's too short to have any
+std::vector<GroceryItemSearch::ItemId> GroceryItemSearch::candidates( std::string_view folded ) const
+{
+  std::vector<ItemId> result;
+
+  std::vector<std::uint32_t> grams;
+  distinct_grams( folded, folded.size() == 2, grams );
+  if( grams.empty() )
+  {
+    result.resize( _items.size() );
+    for( ItemId item = 0; item < result.size(); ++item ) result[item] = item;
+    return result;
+  }
+
+  std::vector<std::span<ItemId const>> lists;
+  for( auto gram : grams )
+  {
+    auto g = std::lower_bound( _grams.begin(), _grams.end(), gram );
+    if( g == _grams.end() || *g != gram ) return result;                     // no item has this gram, so none can match
+
+    auto i = static_cast<std::size_t>( g - _grams.begin() );
+    lists.emplace_back( _postings.data() + _postingOffsets[i], _postingOffsets[i + 1] - _postingOffsets[i] );
+  }
+
+  // Start from the rarest gram and keep only the items every other list also holds.  The candidates only ever shrink, and both
+  // sides are ascending, so each list is searched from where the last item was found.
+  std::sort( lists.begin(), lists.end(), []( auto const & lhs, auto const & rhs ) { return lhs.size() < rhs.size(); } );
+  result.assign( lists.front().begin(), lists.front().end() );
+
+  for( std::size_t l = 1; l < lists.size() && !result.empty(); ++l )
+  {
+    auto from = lists[l].begin();
+    std::erase_if( result, [&]( ItemId item )
+    {
+      from = std::lower_bound( from, lists[l].end(), item );
+      return from == lists[l].end() || *from != item;
+    } );
+  }
+  return result;
+}
+
+
+
+
+// names_of()
+std::string_view GroceryItemSearch::names_of( ItemId item ) const noexcept
+{
+  return std::string_view( _names ).substr( _nameOffsets[item], _nameOffsets[item + 1] - _nameOffsets[item] );
+}
+
+
+
+
+// rank()
+std::size_t GroceryItemSearch::rank( std::string_view names, std::string_view folded ) noexcept
+{
+  auto const separator = names.find( SEPARATOR );
+  auto const product   = names.substr( 0, separator );
+  auto const brand     = names.substr( separator + 1 );
+
+  auto position = product.find( folded );
+  if( position == 0 ) return 0;
+  if( position == std::string_view::npos ) return brand.find( folded ) == std::string_view::npos ? 4 : 3;
+
+  for( ; position != std::string_view::npos; position = product.find( folded, position + 1 ) )
+  {
+    if( !is_word_character( product[position - 1] ) ) return 1;
+  }
+  return 2;
+}
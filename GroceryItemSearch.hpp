@@ -0,0 +1,64 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GroceryItem.hpp"
+
+
+
+
+// Case-insensitive search of a catalog's product and brand names by any part of a name (Ex: "rice krispies" finds "Kellogg's Rice
+// Krispies Cereal - 12 Oz"), for cashiers and kiosks that don't have a UPC to hand.
+//
+// Names are folded to lower case (ASCII letters only; other bytes, including UTF-8 sequences, must match exactly) and every two and
+// three byte window, or bigram and trigram, of each folded name is indexed:  for each distinct gram, the sorted list of items whose
+// product or brand name contains it.  A query of three or more bytes intersects the lists of its trigrams, rarest first, and a two
+// byte query takes its bigram's list, so only items holding every gram are ever compared with the query.  A one byte query has no
+// gram and scans the folded names instead.
+//
+// Matches are ranked best first:
+//   1)  product names that start with the query
+//   2)  product names with a word that starts with the query
+//   3)  product names that contain the query anywhere else
+//   4)  brand names that contain the query
+// then shorter product names first (the closer match), then catalog order.
+//
+// The search refers to the items it was built from (Ex: GroceryItemDatabase::product_search()), and is invalidated when those items
+// are modified, moved, or destroyed.
+class GroceryItemSearch
+{
+  public:
+    // Constructors
+    GroceryItemSearch() = default;
+    explicit GroceryItemSearch( std::span<GroceryItem const> items );
+
+    // Queries
+    std::vector<GroceryItem const *> find( std::string_view query, std::size_t k = 10 ) const;   // the best k items whose product or brand
+                                                                                                  // name contains query, best first.  An
+                                                                                                  // empty query matches nothing
+
+    std::size_t size        () const noexcept;
+    std::size_t memory_bytes() const noexcept;                                // heap memory held by the index, excluding the items themselves
+
+  private:
+    using ItemId = std::uint32_t;
+
+    std::vector<ItemId> candidates( std::string_view folded ) const;
+    std::string_view    names_of  ( ItemId item ) const noexcept;
+
+    static std::size_t  rank      ( std::string_view names, std::string_view folded ) noexcept;   // 0 (best) to 3 as above, 4 if no match
+
+    std::span<GroceryItem const> _items;
+
+    std::string                  _names;                                      // each item's folded product name, a '\0', and its folded brand name
+    std::vector<std::uint32_t>   _nameOffsets{ 0 };                           // item i's names are _names[_nameOffsets[i], _nameOffsets[i+1])
+
+    std::vector<std::uint32_t>   _grams;                                      // distinct bigrams and trigrams, packed and ascending
+    std::vector<std::uint32_t>   _postingOffsets{ 0 };                        // _grams[g]'s items are _postings[_postingOffsets[g], _postingOffsets[g+1])
+    std::vector<ItemId>          _postings;                                   // ascending within each gram
+};
@@ -0,0 +1,70 @@
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iostream>                                                                         // clog
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+#include "GroceryItemSearch.hpp"
+#include "MappedFile.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemSearchBenchmark
+  {
+    public:
+      GroceryItemSearchBenchmark();
+
+    private:
+      void search( std::string const & filename );
+  } run_groceryItemSearch_benchmarks;
+
+
+
+
+  // Build time and memory footprint, then top 10 lookups the way a cashier or kiosk would type them
+  void GroceryItemSearchBenchmark::search( std::string const & filename )
+  {
+    MappedFile const               file( filename );
+    std::vector<GroceryItem> const items = parse_grocery_items( file.bytes() );
+
+    std::clog << "\n" << filename << ":  " << items.size() << " grocery items\n";
+
+    GroceryItemSearch index;
+    auto const        before  = Benchmark::resident_bytes();
+    auto const        seconds = Benchmark::seconds( [&] { index = GroceryItemSearch( items ); }, 1 );
+    auto const        after   = Benchmark::resident_bytes();
+    Benchmark::report_memory( "build - index size",          items.size(), index.memory_bytes(), seconds );
+    Benchmark::report_memory( "build - resident set growth", items.size(), after > before ? after - before : 0, seconds );
+
+    for( std::string_view query : { "rice krispies", "Nestle", "organic", "CHOCOLATE CHIP COOKIES", "oz", "zzqx" } )
+    {
+      std::size_t found = 0;
+      auto        time  = Benchmark::seconds( [&] { found = index.find( query ).size(); Benchmark::do_not_optimize( found ); } );
+      Benchmark::report( "top 10 \"" + std::string( query ) + "\" (" + std::to_string( found ) + " found)", 1, time );
+    }
+  }
+
+
+
+
+  GroceryItemSearchBenchmark::GroceryItemSearchBenchmark()
+  {
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Search Benchmarks:  Product and brand name search\n";
+      for( auto const & filename : Benchmark::database_files() ) search( filename );
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Benchmarks for \"class GroceryItemSearch\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
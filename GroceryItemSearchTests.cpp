@@ -0,0 +1,154 @@
+#include <algorithm>                                                                        // sort(), min()
+#include <cctype>                                                                           // tolower(), isalnum()
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemDatabase.hpp"
+#include "GroceryItemParser.hpp"
+#include "GroceryItemSearch.hpp"
+#include "MappedFile.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemSearchRegressionTest
+  {
+    public:
+      GroceryItemSearchRegressionTest();
+
+    private:
+      void examples();
+      void reference();
+
+      Regression::CheckResults affirm;
+  } run_groceryItemSearch_tests;
+
+
+
+
+  std::string lower( std::string_view text )
+  {
+    std::string result;
+    for( unsigned char c : text ) result.push_back( c < 0x80 ? static_cast<char>( std::tolower( c ) ) : static_cast<char>( c ) );
+    return result;
+  }
+
+
+
+
+  // The reference:  fold and rank every item the slow, obvious way
+  std::vector<GroceryItem const *> brute_force( std::vector<GroceryItem> const & items, std::string_view query, std::size_t k )
+  {
+    auto const q = lower( query );
+    std::vector<std::tuple<int, std::size_t, std::size_t>> matches;
+    for( std::size_t i = 0; i < items.size() && !q.empty(); ++i )
+    {
+      auto const product = lower( items[i].productName() );
+      auto const brand   = lower( items[i].brandName() );
+
+      int rank = 4;
+      for( auto position = product.find( q ); position != std::string::npos; position = product.find( q, position + 1 ) )
+      {
+        auto const before     = position == 0 ? ' ' : static_cast<unsigned char>( product[position - 1] );
+        bool const wordStarts = before < 0x80 && !std::isalnum( before );
+        int  const r          = position == 0 ? 0 : wordStarts ? 1 : 2;
+        rank = std::min( rank, r );
+      }
+      if( rank == 4 && brand.find( q ) != std::string::npos ) rank = 3;
+      if( rank < 4 ) matches.emplace_back( rank, product.size(), i );
+    }
+    std::sort( matches.begin(), matches.end() );
+
+    std::vector<GroceryItem const *> result;
+    for( std::size_t i = 0; i < std::min( k, matches.size() ); ++i ) result.push_back( &items[std::get<2>( matches[i] )] );
+    return result;
+  }
+
+
+
+
+  void GroceryItemSearchRegressionTest::examples()
+  {
+    GroceryItemDatabase database( "Grocery_UPC_Database-Small.dat" );
+    auto const          search = database.product_search();
+
+    auto names = [&]( std::string_view query, std::size_t k = 10 )                            // product names, best first, one string
+    {
+      std::string result;
+      for( auto item : search.find( query, k ) ) result += ( result.empty() ? "" : " | " ) + std::string( item->productName() );
+      return result;
+    };
+
+    affirm.is_equal( "Search - product name, then brand name            ", std::string( "Kellogg's Rice Krispies Cereal | Kellogg's Cocoa Krispies Cereal" ), names( "Rice Krispies" ) );
+    affirm.is_equal( "Search - case-insensitive                         ", names( "Rice Krispies" ), names( "rICE kRISPIES" ) );
+    affirm.is_equal( "Search - prefixes first, shortest first           ", std::string( "Rice Qckck 4blnd | Rice 3vrty Palt 432pc" ), names( "rice", 2 ) );
+    affirm.is_equal( "Search - top k                                    ", std::size_t{ 3 }, search.find( "e", 3 ).size() );
+    affirm.is_true ( "Search - no match                                 ", search.find( "zzzqqq" ).empty() && search.find( "" ).empty() && search.find( "rice", 0 ).empty() );
+    affirm.is_true ( "Search - empty catalog                            ", GroceryItemSearch().find( "rice" ).empty() && GroceryItemSearch().size() == 0 );
+    affirm.is_equal( "Search - size                                     ", database.size(), search.size() );
+  }
+
+
+
+
+  // Queries of every length, including ones shorter than a trigram, ones spanning words, and ones found only in brand names, agree
+  // with the brute force reference, in order
+  void GroceryItemSearchRegressionTest::reference()
+  {
+    MappedFile               file( "Grocery_UPC_Database-Small.dat" );
+    std::vector<GroceryItem> items = parse_grocery_items( file.bytes() );
+    items.emplace_back( "00000000000001", "Café Bustelo", "CAFÉ Bustelo Espresso - 10 Oz", 4.99 );
+    items.emplace_back( "00000000000002", "",             "",                              0.99 );
+
+    GroceryItemSearch const search( items );
+
+    std::vector<std::string> queries = { "a", "Z", "ri", "oz", "-", " ", "rice", "Krispies", "cereal", "s cer", "nature's own", "nestle",
+                                         "NESTLE MEDIA", "butter buns hotdog - 8 ct", "café", "CAFÉ", "é", "espresso", "0", "12", "xyz" };
+    for( auto const & item : items )                                                         // every name, and a slice of it, finds itself
+    {
+      queries.emplace_back( item.productName() );
+      queries.emplace_back( item.brandName() );
+      if( item.productName().size() > 6 ) queries.emplace_back( item.productName().substr( 2, 4 ) );
+    }
+
+    bool allMatch = true;
+    for( auto const & query : queries )
+    {
+      for( std::size_t k : { 1, 5, 1'000 } ) allMatch = allMatch && search.find( query, k ) == brute_force( items, query, k );
+    }
+    affirm.is_true( "Search - agrees with brute force                  ", allMatch );
+  }
+
+
+
+
+  GroceryItemSearchRegressionTest::GroceryItemSearchRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Search Regression Test:\n";
+      examples();
+      reference();
+
+      std::clog << "\n\nGroceryItem Search Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class GroceryItemSearch\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -0,0 +1,280 @@
+#include <algorithm>                                                          // copy_n()
+#include <bit>                                                                // rotl()
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // int64_t, uint32_t, uint64_t
+#include <cstring>                                                            // memcpy()
+#include <filesystem>                                                         // path, rename(), remove()
+#include <fstream>                                                            // ofstream
+#include <memory_resource>                                                    // memory_resource
+#include <random>                                                             // random_device
+#include <stdexcept>                                                          // invalid_argument, runtime_error
+#include <string>                                                             // to_string()
+#include <string_view>
+#include <system_error>                                                       // error_code
+#include <type_traits>                                                        // is_trivially_copyable_v
+#include <utility>                                                            // move()
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryItemSnapshot.hpp"
+#include "Money.hpp"
+#include "UpcIndex.hpp"
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  constexpr char          MAGIC[8]        = { 'G', 'R', 'O', 'C', 'S', 'N', 'A', 'P' };
+  constexpr std::uint32_t BYTE_ORDER_MARK = 0x0102'0304;                      // reads back as 0x0403'0201 on a machine with the other byte order
+
+  struct Header
+  {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t fileSize;
+    std::uint64_t checksum;                                                   // of every byte after the header
+    std::uint64_t recordCount;
+    std::uint64_t recordsOffset;
+    std::uint64_t heapOffset;
+    std::uint64_t heapSize;
+    std::uint64_t indexOffset;
+    std::uint64_t indexSlots;                                                 // number of keys, and of positions
+    std::uint64_t unpackedCount;
+  };
+
+  struct Record
+  {
+    std::uint64_t upcOffset;                                                  // offsets are relative to the start of the string heap
+    std::uint64_t brandOffset;
+    std::uint64_t productOffset;
+    std::uint32_t upcLength;
+    std::uint32_t brandLength;
+    std::uint32_t productLength;
+    std::uint32_t reserved;                                                   // always zero, keeps price 8-byte aligned
+    std::int64_t  priceInCents;
+  };
+
+  static_assert( std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<Record> );
+  static_assert( sizeof( Record ) == 48, "the record table's width is part of the file format" );
+
+
+
+  constexpr std::uint64_t align8( std::uint64_t n ) noexcept
+  {
+    return ( n + 7 ) & ~std::uint64_t{ 7 };
+  }
+
+
+
+  // True if [offset, offset + length) lies within [0, limit), without overflowing
+  constexpr bool within( std::uint64_t offset, std::uint64_t length, std::uint64_t limit ) noexcept
+  {
+    return offset <= limit && length <= limit - offset;
+  }
+
+
+
+  // A fast 64-bit checksum, consuming eight bytes per step.  It is meant to catch truncated, torn, or corrupted files, not
+  // tampering.
+  std::uint64_t checksum_of( std::string_view bytes ) noexcept
+  {
+    constexpr std::uint64_t PRIME1 = 0x9E37'79B1'85EB'CA87ULL;
+    constexpr std::uint64_t PRIME2 = 0xC2B2'AE3D'27D4'EB4FULL;
+
+    std::uint64_t hash = PRIME1 ^ bytes.size();
+    std::size_t   i    = 0;
+    for( ; i + 8 <= bytes.size(); i += 8 )
+    {
+      std::uint64_t word;
+      std::memcpy( &word, bytes.data() + i, sizeof( word ) );
+      hash = std::rotl( hash ^ ( word * PRIME2 ), 31 ) * PRIME1;
+    }
+    for( ; i < bytes.size(); ++i ) hash = std::rotl( hash ^ ( static_cast<unsigned char>( bytes[i] ) * PRIME2 ), 11 ) * PRIME1;
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    return hash ^ ( hash >> 29 );
+  }
+
+
+
+  template<typename T>
+  void put( std::string & image, std::uint64_t offset, T const & value ) noexcept
+  {
+    std::memcpy( image.data() + offset, &value, sizeof( value ) );
+  }
+
+  template<typename T>
+  T get( std::string_view bytes, std::uint64_t offset ) noexcept
+  {
+    T value;
+    std::memcpy( &value, bytes.data() + offset, sizeof( value ) );
+    return value;
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Snapshot Operations
+*******************************************************************************/
+
+// is_snapshot()
+bool GroceryItemSnapshot::is_snapshot( std::string_view bytes ) noexcept
+{
+  return bytes.starts_with( std::string_view( MAGIC, sizeof( MAGIC ) ) );
+}
+
+
+
+
+// write()
+void GroceryItemSnapshot::write( std::string const & filename, std::vector<GroceryItem> const & dataStore, UpcIndex const & index )
+{
+  Header header{};
+  std::copy_n( MAGIC, sizeof( MAGIC ), header.magic );
+  header.version       = VERSION;
+  header.byteOrder     = BYTE_ORDER_MARK;
+  header.recordCount   = dataStore.size();
+  header.recordsOffset = align8( sizeof( Header ) );
+  header.heapOffset    = header.recordsOffset + header.recordCount * sizeof( Record );
+
+  for( auto const & item : dataStore ) header.heapSize += item.upcCode().size() + item.brandName().size() + item.productName().size();
+
+  header.indexOffset   = align8( header.heapOffset + header.heapSize );
+  header.indexSlots    = index.keys().size();
+  header.unpackedCount = index.unpacked().size();
+  header.fileSize      = header.indexOffset + header.indexSlots    * ( sizeof( std::uint64_t ) + sizeof( std::uint32_t ) )
+                                            + header.unpackedCount *   sizeof( std::uint32_t );
+
+  // Lay out the whole image in memory, then checksum and write it in one go
+  std::string   image( header.fileSize, '\0' );
+  std::uint64_t heapEnd = 0;
+  auto          append  = [&]( std::string_view field, std::uint64_t & offset, std::uint32_t & length )
+  {
+    offset = heapEnd;
+    length = static_cast<std::uint32_t>( field.size() );
+    std::memcpy( image.data() + header.heapOffset + heapEnd, field.data(), field.size() );
+    heapEnd += field.size();
+  };
+
+  for( std::size_t i = 0; i < dataStore.size(); ++i )
+  {
+    Record record{};
+    append( dataStore[i].upcCode(),     record.upcOffset,     record.upcLength     );
+    append( dataStore[i].brandName(),   record.brandOffset,   record.brandLength   );
+    append( dataStore[i].productName(), record.productOffset, record.productLength );
+    record.priceInCents = dataStore[i].exactPrice().cents();
+    put( image, header.recordsOffset + i * sizeof( Record ), record );
+  }
+
+  auto const positionsOffset = header.indexOffset + header.indexSlots * sizeof( std::uint64_t );
+  auto const unpackedOffset  = positionsOffset    + header.indexSlots * sizeof( std::uint32_t );
+  std::memcpy( image.data() + header.indexOffset, index.keys()     .data(), index.keys()     .size() * sizeof( std::uint64_t ) );
+  std::memcpy( image.data() + positionsOffset,    index.positions().data(), index.positions().size() * sizeof( std::uint32_t ) );
+  std::memcpy( image.data() + unpackedOffset,     index.unpacked() .data(), index.unpacked() .size() * sizeof( std::uint32_t ) );
+
+  header.checksum = checksum_of( std::string_view( image ).substr( sizeof( Header ) ) );
+  put( image, 0, header );
+
+  // Written whole to a temporary file in the same directory, then renamed over filename, so a process opening (or reloading, see
+  // ConcurrentGroceryItemDatabase::watch()) the snapshot maps either the previous file or the new one, never one half written or
+  // truncated under it.  The rename replaces the directory entry only;  a mapping of the previous file stays valid.
+  std::filesystem::path const target    = filename;
+  std::filesystem::path       temporary = target;
+  temporary += ".tmp-" + std::to_string( std::random_device{}() );
+
+  {
+    std::ofstream fout( temporary, std::ios::binary | std::ios::trunc );
+    if( !fout.write( image.data(), static_cast<std::streamsize>( image.size() ) ) || !fout.flush() )
+    {
+      fout.close();
+      std::error_code ignored;
+      std::filesystem::remove( temporary, ignored );
+      throw std::runtime_error( "Error - Could not write grocery item database snapshot \"" + filename + '"' );
+    }
+  }
+
+  std::error_code renameError;
+  std::filesystem::rename( temporary, target, renameError );
+  if( renameError )
+  {
+    std::error_code ignored;
+    std::filesystem::remove( temporary, ignored );
+    throw std::runtime_error( "Error - Could not replace grocery item database snapshot \"" + filename + "\":  " + renameError.message() );
+  }
+}
+
+
+
+
+// read()
+bool GroceryItemSnapshot::read( std::string_view bytes, std::vector<GroceryItem> & dataStore, UpcIndex & index, std::pmr::memory_resource * resource )
+{
+  if( bytes.size() < sizeof( Header ) || !is_snapshot( bytes ) ) return false;
+
+  auto const header = get<Header>( bytes, 0 );
+  auto const slotsSize = header.indexSlots * ( sizeof( std::uint64_t ) + sizeof( std::uint32_t ) );
+
+  if(    header.version   != VERSION
+      || header.byteOrder != BYTE_ORDER_MARK
+      || header.fileSize  != bytes.size()
+      || header.recordsOffset < sizeof( Header )
+      || header.recordCount   > bytes.size() / sizeof( Record )
+      || header.indexSlots    > bytes.size() / sizeof( std::uint64_t )
+      || header.unpackedCount > bytes.size() / sizeof( std::uint32_t )
+      || !within( header.recordsOffset, header.recordCount * sizeof( Record ), bytes.size() )
+      || !within( header.heapOffset,    header.heapSize,                       bytes.size() )
+      || !within( header.indexOffset,   slotsSize + header.unpackedCount * sizeof( std::uint32_t ), bytes.size() )
+      || header.checksum != checksum_of( bytes.substr( sizeof( Header ) ) ) )
+  {
+    return false;
+  }
+
+  auto const heap = bytes.substr( header.heapOffset, header.heapSize );
+
+  std::vector<GroceryItem> items;
+  items.reserve( header.recordCount );
+  for( std::uint64_t i = 0; i < header.recordCount; ++i )
+  {
+    auto const record = get<Record>( bytes, header.recordsOffset + i * sizeof( Record ) );
+    if(    !within( record.upcOffset,     record.upcLength,     heap.size() )
+        || !within( record.brandOffset,   record.brandLength,   heap.size() )
+        || !within( record.productOffset, record.productLength, heap.size() ) ) return false;
+
+    items.emplace_back( heap.substr( record.productOffset, record.productLength ),
+                        heap.substr( record.brandOffset,   record.brandLength   ),
+                        heap.substr( record.upcOffset,     record.upcLength     ),
+                        Money::from_cents( record.priceInCents ),
+                        resource );
+  }
+
+  std::vector<std::uint64_t> keys     ( header.indexSlots    );
+  std::vector<std::uint32_t> positions( header.indexSlots    );
+  std::vector<std::uint32_t> unpacked ( header.unpackedCount );
+  auto const positionsOffset = header.indexOffset + header.indexSlots * sizeof( std::uint64_t );
+  auto const unpackedOffset  = positionsOffset    + header.indexSlots * sizeof( std::uint32_t );
+  std::memcpy( keys     .data(), bytes.data() + header.indexOffset, keys     .size() * sizeof( std::uint64_t ) );
+  std::memcpy( positions.data(), bytes.data() + positionsOffset,    positions.size() * sizeof( std::uint32_t ) );
+  std::memcpy( unpacked .data(), bytes.data() + unpackedOffset,     unpacked .size() * sizeof( std::uint32_t ) );
+
+  try
+  {
+    index = UpcIndex( std::move( keys ), std::move( positions ), std::move( unpacked ), items.size() );
+  }
+  catch( std::invalid_argument const & )
+  {
+    return false;
+  }
+
+  dataStore = std::move( items );
+  return true;
+}
@@ -0,0 +1,45 @@
+#pragma once                                                                  // include guard
+
+#include <cstdint>                                                            // uint32_t
+#include <memory_resource>                                                    // memory_resource, get_default_resource()
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "UpcIndex.hpp"
+
+
+
+
+// A compact, versioned, checksummed binary image of a grocery item database that loads without parsing the quoted text format.
+//
+//   Offset              Contents
+//   ------------------  -------------------------------------------------------------------------------------------------------
+//   0                   Header:  magic "GROCSNAP", format version, byte order mark, counts, section offsets, and a checksum of
+//                                everything after the header
+//   recordsOffset       Record table:  one fixed width record per grocery item, in data store order.  Each holds the price in cents and
+//                                the offset and length of its UPC, brand name, and product name within the string heap
+//   heapOffset          String heap:  every field's characters, unescaped, back to back
+//   indexOffset         UPC index:  the prebuilt UpcIndex table (keys, then positions, then positions of unpacked UPCs), adopted as
+//                                is so nothing is rehashed at startup
+//
+// Integers and prices are stored in the byte order of the machine that wrote the snapshot.  A snapshot written on a machine with
+// the other byte order fails the byte order check and is rejected, as is one with a different version or a bad checksum.
+class GroceryItemSnapshot
+{
+  public:
+    static constexpr std::uint32_t VERSION = 2;                               // 2:  prices in whole cents rather than double dollars
+
+    // Returns true if bytes begin like a snapshot (magic number only, nothing is validated).  Used to tell a snapshot from a text
+    // database file.
+    static bool is_snapshot( std::string_view bytes ) noexcept;
+
+    // Writes dataStore and its index to filename, atomically:  readers see the previous file or the complete new one, never a partial
+    // one.  Throws std::runtime_error, leaving any previous file in place, if the file can't be written.
+    static void write( std::string const & filename, std::vector<GroceryItem> const & dataStore, UpcIndex const & index );
+
+    // Reconstructs a data store and its index from a snapshot's bytes, allocating the grocery items' strings from resource.  Returns
+    // false, leaving dataStore and index unchanged, if the bytes are not a valid snapshot of this version.
+    static bool read( std::string_view bytes, std::vector<GroceryItem> & dataStore, UpcIndex & index, std::pmr::memory_resource * resource = std::pmr::get_default_resource() );
+};
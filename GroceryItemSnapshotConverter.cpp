@@ -0,0 +1,63 @@
+// Converts a grocery item database text file into a binary snapshot GroceryItemDatabase::instance() will load in its place,
+// optionally compacting deltas into it first.
+//
+// Usage:  GroceryItemSnapshotConverter  database.dat  [snapshot  [delta ...]]
+//
+//   database.dat   a grocery item database in the quoted text format (Ex: Grocery_UPC_Database-Full.dat), or a previous snapshot
+//   snapshot       where to write the snapshot.  Defaults to the database's name with the extension replaced by ".snapshot", which
+//                  is where instance() looks for it.
+//   delta          delta files of upserts and erases (see GroceryItemDatabase::apply_delta()), applied in the order given and merged
+//                  into the snapshot as a fresh base.
+//
+// Build this file as its own program, linked with GroceryItem.cpp, GroceryItemDatabase.cpp, and the files they depend on.
+
+#include <algorithm>                                                                        // max()
+#include <exception>
+#include <filesystem>                                                                       // path, exists()
+#include <iostream>                                                                         // cout, cerr
+#include <string>
+#include <thread>                                                                           // hardware_concurrency()
+
+#include "GroceryItemDatabase.hpp"
+
+
+
+int main( int argc, char * argv[] )
+{
+  try
+  {
+    if( argc < 2 )
+    {
+      std::cerr << "Usage:  " << argv[0] << "  database.dat  [snapshot  [delta ...]]\n";
+      return 2;
+    }
+
+    std::string const input  = argv[1];
+    std::string const output = argc >= 3 ? argv[2] : std::filesystem::path( input ).replace_extension( ".snapshot" ).string();
+
+    if( !std::filesystem::exists( input ) )
+    {
+      std::cerr << "ERROR:  grocery item database \"" << input << "\" not found\n";
+      return 1;
+    }
+
+    GroceryItemDatabase database( input, std::max( 1U, std::thread::hardware_concurrency() ) );
+
+    for( int i = 3; i < argc; ++i )
+    {
+      auto counts = database.apply_delta( std::string( argv[i] ) );
+      std::cout << "Applied \"" << argv[i] << "\":  " << counts.inserted << " inserted, " << counts.updated << " updated, " << counts.erased << " erased\n";
+    }
+
+    database.compact( output );
+
+    std::cout << "Wrote " << database.size() << " grocery items from \"" << input << "\" to \"" << output << "\"\n";
+  }
+
+  catch( std::exception & ex )
+  {
+    std::cerr << "ERROR:  Unhandled exception:  " << ex.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
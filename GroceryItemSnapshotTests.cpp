@@ -0,0 +1,190 @@
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <filesystem>                                                                       // temp_directory_path(), remove(), copy_file(), directory_iterator
+#include <fstream>                                                                          // ofstream
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <string>
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemDatabase.hpp"
+#include "GroceryItemParser.hpp"
+#include "GroceryItemSnapshot.hpp"
+#include "MappedFile.hpp"
+#include "UpcIndex.hpp"
+
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemSnapshotRegressionTest
+  {
+    public:
+      GroceryItemSnapshotRegressionTest();
+
+    private:
+      void roundTrip();
+      void rejection();
+
+      Regression::CheckResults affirm;
+  } run_groceryItemSnapshot_tests;
+
+
+
+
+  std::vector<GroceryItem> sample_items()
+  {
+    MappedFile file( "Grocery_UPC_Database-Small.dat" );
+    auto       items = parse_grocery_items( file.bytes() );
+
+    // Make sure escapes, empty fields, and UPCs that can't be packed survive too
+    items.emplace_back( "Smart Living 10.5\" X 8\" 3 Subject Notebook College Ruled", "Smart Living", "00041520893307", 18.98 );
+    items.emplace_back( "", "", "", 0.0 );
+    items.emplace_back( "grocery item's product name", "grocery item's brand name", "grocery item's UPC code", 123.79 );
+    return items;
+  }
+
+
+
+
+  void GroceryItemSnapshotRegressionTest::roundTrip()
+  {
+    auto const path  = ( std::filesystem::temp_directory_path() / "GroceryItemSnapshotTests.snapshot" ).string();
+    auto const items = sample_items();
+    UpcIndex   index( items );
+
+    GroceryItemSnapshot::write( path, items, index );
+
+    std::vector<GroceryItem> loadedItems;
+    UpcIndex                 loadedIndex;
+    {
+      MappedFile file( path );
+      affirm.is_true( "Snapshot round trip - recognized as a snapshot    ", GroceryItemSnapshot::is_snapshot( file.bytes() ) );
+      affirm.is_true( "Snapshot round trip - read succeeds               ", GroceryItemSnapshot::read( file.bytes(), loadedItems, loadedIndex ) );
+    }
+
+    bool identical = loadedItems.size() == items.size();
+    for( std::size_t i = 0; identical && i < items.size(); ++i ) identical = items[i] == loadedItems[i] && items[i].price() == loadedItems[i].price();
+    affirm.is_true( "Snapshot round trip - identical grocery items     ", identical );
+
+    bool indexed = loadedIndex.size() == index.size();
+    for( auto const & item : items ) indexed = indexed && loadedIndex.find( loadedItems, item.upcCode() ) == index.find( items, item.upcCode() );
+    affirm.is_true( "Snapshot round trip - identical UPC index         ", indexed );
+
+    {
+      GroceryItemDatabase db( path );
+      auto                p = db.find( "00014100072331" );
+      affirm.is_equal( "Snapshot round trip - database size               ", items.size(), db.size() );
+      affirm.is_true ( "Snapshot round trip - database query              ", p != nullptr && p->productName() == "Pepperidge Farm \n          Classic Cookie Favorites" );
+    }
+
+    std::filesystem::remove( path );
+  }
+
+
+
+
+  void GroceryItemSnapshotRegressionTest::rejection()
+  {
+    auto const path  = ( std::filesystem::temp_directory_path() / "GroceryItemSnapshotTests.snapshot" ).string();
+    auto const items = sample_items();
+    GroceryItemSnapshot::write( path, items, UpcIndex( items ) );
+
+    std::string image;
+    {
+      MappedFile file( path );
+      image = file.bytes();
+    }
+
+    // Rewriting a snapshot a reader still has mapped replaces the file whole, leaving the reader's mapping intact and no temporary
+    // file behind
+    {
+      MappedFile  previous( path );
+      std::string before( previous.bytes() );
+      auto        fewer = items;
+      fewer.pop_back();
+      GroceryItemSnapshot::write( path, fewer, UpcIndex( fewer ) );
+
+      std::vector<GroceryItem> loadedItems;
+      UpcIndex                 loadedIndex;
+      MappedFile               current( path );
+      affirm.is_true( "Snapshot rewrite - previous mapping intact        ", previous.bytes() == before && GroceryItemSnapshot::read( current.bytes(), loadedItems, loadedIndex ) && loadedItems.size() == fewer.size() );
+
+      std::size_t leftovers = 0;
+      for( auto const & entry : std::filesystem::directory_iterator( std::filesystem::path( path ).parent_path() ) )
+      {
+        if( entry.path().filename().string().starts_with( "GroceryItemSnapshotTests.snapshot.tmp" ) ) ++leftovers;
+      }
+      affirm.is_equal( "Snapshot rewrite - no temporary file left behind  ", std::size_t( 0 ), leftovers );
+    }
+    std::filesystem::remove( path );
+
+    auto rejected = [&]( std::string const & bytes )
+    {
+      std::vector<GroceryItem> loadedItems{ { "unchanged" } };
+      UpcIndex                 loadedIndex;
+      return !GroceryItemSnapshot::read( bytes, loadedItems, loadedIndex ) && loadedItems.size() == 1 && loadedItems[0].productName() == "unchanged";
+    };
+
+    std::string corrupted = image;
+    corrupted[corrupted.size() / 2] ^= 0x20;
+    affirm.is_true( "Snapshot rejection - corrupted byte               ", rejected( corrupted ) );
+
+    affirm.is_true( "Snapshot rejection - truncated                    ", rejected( image.substr( 0, image.size() - 1 ) ) );
+    affirm.is_true( "Snapshot rejection - header only                  ", rejected( image.substr( 0, 64 ) ) );
+
+    std::string newerVersion = image;
+    newerVersion[8] = static_cast<char>( newerVersion[8] + 1 );                             // the version immediately follows the 8-byte magic number
+    affirm.is_true( "Snapshot rejection - different version            ", rejected( newerVersion ) );
+
+    affirm.is_true( "Snapshot rejection - text database                ", !GroceryItemSnapshot::is_snapshot( "\"00072250018548\",\"Nature's Own\"" ) );
+
+    // A database opened from a torn snapshot loads the text file it was made from instead, or is empty if there is none
+    {
+      auto const source = std::filesystem::path( path ).replace_extension( ".dat" );
+      {
+        std::ofstream torn( path, std::ios::binary | std::ios::trunc );
+        torn.write( image.data(), static_cast<std::streamsize>( image.size() / 2 ) );
+      }
+
+      GroceryItemDatabase const orphan( path );
+      affirm.is_equal( "Snapshot rejection - no text file, empty database ", std::size_t( 0 ), orphan.size() );
+
+      std::filesystem::copy_file( "Grocery_UPC_Database-Small.dat", source, std::filesystem::copy_options::overwrite_existing );
+      GroceryItemDatabase const fallback( path );
+      GroceryItemDatabase const text    ( "Grocery_UPC_Database-Small.dat" );
+      affirm.is_true( "Snapshot rejection - falls back to the text file  ", fallback.size() == text.size() && fallback.size() > 0 );
+
+      std::filesystem::remove( path );
+      std::filesystem::remove( source );
+    }
+  }
+
+
+
+  GroceryItemSnapshotRegressionTest::GroceryItemSnapshotRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nGroceryItem Snapshot Regression Test:  Round trip\n";
+      roundTrip();
+
+      std::clog << "\nGroceryItem Snapshot Regression Test:  Rejection\n";
+      rejection();
+
+      std::clog << "\n\nGroceryItem Snapshot Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"GroceryItemSnapshot\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
@@ -170,8 +170,8 @@ namespace  // anonymous
     affirm.is_not_equal( "Inequality Product Name test                      ", less, GroceryItem {"b1", "a1", "a1", 10.0} );
     affirm.is_not_equal( "Inequality Brand Name test                        ", less, GroceryItem {"a1", "b1", "a1", 10.0} );
     affirm.is_not_equal( "Inequality UPC test                               ", less, GroceryItem {"a1", "a1", "b1", 10.0} );
-    affirm.is_not_equal( "Inequality Price test - lower limit               ", less, GroceryItem {"a1", "a1", "a1", less.price() - ( 2 * EPSILON )} );
-    affirm.is_not_equal( "Inequality Price test - upper limit               ", less, GroceryItem {"a1", "a1", "a1", less.price() + ( 2 * EPSILON )} );
+    affirm.is_not_equal( "Inequality Price test - lower limit               ", less, GroceryItem {"a1", "a1", "a1", less.price() - 0.01} );   // prices are exact to the cent
+    affirm.is_not_equal( "Inequality Price test - upper limit               ", less, GroceryItem {"a1", "a1", "a1", less.price() + 0.01} );
 
 
     auto check = [&]()
@@ -194,6 +194,39 @@ namespace  // anonymous
 
     more = {"a0", "a0", "a2", 9.0};
     affirm.is_true( "Relational UPC code test                          ", check() );
+
+
+    {  // UPC codes order exactly as their strings do, whether decided by the sort keys or left to the strings:  codes that agree in
+       // their first 16 bytes or more, codes continuing with zero bytes, bytes above 0x7F, and codes changed after construction
+      std::string const codes[] = { "", "0", "00014100072331", "00014100072332", "0001410007233", "1", "12844098150", "9",
+                                    "grocery item's UPC code", "grocery item's UPC code 2", "grocery item's", std::string( "1\0", 2 ),
+                                    std::string( "1\0\0", 3 ), "\x7F", "\x80", "\xFF", std::string( 16, 'x' ), std::string( 17, 'x' ) };
+      bool agrees = true;
+      for( auto const & lhs : codes ) for( auto const & rhs : codes )
+      {
+        GroceryItem a( "p", "b", lhs, 1.0 ), b( "p", "b", "placeholder", 1.0 );
+        b.upcCode( rhs );
+        agrees = agrees && ( a <=> b ) == ( lhs <=> rhs ) && ( a == b ) == ( lhs == rhs );
+      }
+
+      GroceryItem moved( "p", "b", "00014100072331", 1.0 );
+      std::move( moved ).upcCode();
+      agrees = agrees && ( moved <=> GroceryItem( "p", "b", moved.upcCode(), 1.0 ) ) == 0;
+      affirm.is_true( "Relational UPC code test - sort keys agree        ", agrees );
+
+      // Moved-from items order by whatever they now hold, just like items constructed from those fields
+      auto rebuilt = []( GroceryItem const & item ) { return GroceryItem( item.productName(), item.brandName(), item.upcCode(), item.exactPrice() ); };
+      bool movedFrom = true;
+      for( auto const & code : { std::string( "00014100072331" ), std::string( 40, 'x' ) } )
+      {
+        GroceryItem source( "p", "b", code, 1.0 ), other( "p", "b", code, 1.0 ), assigned;
+        GroceryItem constructed( std::move( source ) );
+        assigned = std::move( other );
+        movedFrom = movedFrom && ( source <=> rebuilt( source ) ) == 0 && ( other <=> rebuilt( other ) ) == 0
+                              && ( source <=> GroceryItem( {}, {}, {}, source.exactPrice() ) ) == ( rebuilt( source ) <=> GroceryItem( {}, {}, {}, source.exactPrice() ) );
+      }
+      affirm.is_true( "Relational UPC code test - moved-from items order ", movedFrom );
+    }
   }
 
 
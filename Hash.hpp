@@ -0,0 +1,15 @@
+#pragma once                                                                  // include guard
+
+#include <cstdint>                                                            // uint64_t
+
+
+
+
+// A 64-bit mixer (the splitmix64 finalizer):  every bit of key affects every bit of the result, so highly regular keys (Ex: packed
+// UPCs, all the same length and nearby in value) and consecutive integers come out as unrelated bit patterns.  Not cryptographic.
+constexpr std::uint64_t hash_of( std::uint64_t key ) noexcept
+{
+  key = ( key ^ ( key >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+  key = ( key ^ ( key >> 27 ) ) * 0x94D049BB133111EBULL;
+  return key ^ ( key >> 31 );
+}
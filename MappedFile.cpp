@@ -0,0 +1,177 @@
+#include <algorithm>                                                          // min()
+#include <cstddef>                                                            // size_t
+#include <fstream>                                                            // ifstream
+#include <iterator>                                                           // istreambuf_iterator
+#include <string>
+#include <string_view>
+#include <utility>                                                            // exchange(), move()
+
+#if __has_include( <sys/mman.h> )
+  #include <fcntl.h>                                                          // open()
+  #include <sys/mman.h>                                                       // mmap(), munmap(), madvise()
+  #include <sys/stat.h>                                                       // fstat()
+  #include <unistd.h>                                                         // close(), sysconf()
+  #define GROCERY_HAS_MMAP 1
+#endif
+
+#include "MappedFile.hpp"
+
+
+
+
+/*******************************************************************************
+**  Constructors, assignments, and destructor
+*******************************************************************************/
+
+// Construct from a file name
+MappedFile::MappedFile( std::string const & filename )
+{
+  #ifdef GROCERY_HAS_MMAP
+    int fd = ::open( filename.c_str(), O_RDONLY );
+    if( fd < 0 ) return;
+
+    struct stat status{};
+    if( ::fstat( fd, &status ) == 0 )
+    {
+      _open = true;
+      _size = static_cast<std::size_t>( status.st_size );
+
+      if( _size > 0 )                                                         // mapping zero bytes is an error, but an empty file is not
+      {
+        void * address = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( address != MAP_FAILED )
+        {
+          ::madvise( address, _size, MADV_SEQUENTIAL );                       // records are parsed front to back, so read ahead aggressively
+          _data   = static_cast<char const *>( address );
+          _mapped = true;
+        }
+        else
+        {
+          _open = false;
+          _size = 0;
+        }
+      }
+    }
+    ::close( fd );                                                            // the mapping remains valid after the descriptor is closed
+
+  #else
+    std::ifstream fin( filename, std::ios::binary );
+    if( !fin.is_open() ) return;
+
+    _copy.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+    _data = _copy.data();
+    _size = _copy.size();
+    _open = true;
+  #endif
+}
+
+
+
+
+// Move constructor
+MappedFile::MappedFile( MappedFile && other ) noexcept
+  : _data  ( std::exchange( other._data,   nullptr ) ),
+    _size  ( std::exchange( other._size,   0       ) ),
+    _open  ( std::exchange( other._open,   false   ) ),
+    _mapped( std::exchange( other._mapped, false   ) ),
+    _copy  ( std::move    ( other._copy            ) )
+{
+  if( !_mapped && _open ) _data = _copy.data();                               // short strings move by copying their bytes, so re-point at ours
+}
+
+
+
+
+// Move Assignment Operator
+MappedFile & MappedFile::operator=( MappedFile && rhs ) & noexcept
+{
+  if( this != &rhs )
+  {
+    release();
+    _data   = std::exchange( rhs._data,   nullptr );
+    _size   = std::exchange( rhs._size,   0       );
+    _open   = std::exchange( rhs._open,   false   );
+    _mapped = std::exchange( rhs._mapped, false   );
+    _copy   = std::move    ( rhs._copy            );
+    if( !_mapped && _open ) _data = _copy.data();
+  }
+  return *this;
+}
+
+
+
+
+// Destructor
+MappedFile::~MappedFile() noexcept
+{
+  release();
+}
+
+
+
+
+// release()
+void MappedFile::release() noexcept
+{
+  #ifdef GROCERY_HAS_MMAP
+    if( _mapped ) ::munmap( const_cast<char *>( _data ), _size );
+  #endif
+
+  _data   = nullptr;
+  _size   = 0;
+  _open   = false;
+  _mapped = false;
+  _copy.clear();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// is_open()
+bool MappedFile::is_open() const noexcept
+{
+  return _open;
+}
+
+
+
+
+// bytes()
+std::string_view MappedFile::bytes() const noexcept
+{
+  return { _data, _size };
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// release_before()
+void MappedFile::release_before( std::size_t offset ) noexcept
+{
+  #ifdef GROCERY_HAS_MMAP
+    // Only whole pages can be released, so round down.  The mapping is private and read-only, so dropping its pages discards nothing.
+    static std::size_t const pageSize = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+
+    auto const bytes = std::min( offset, _size ) / pageSize * pageSize;
+    if( _mapped && bytes > 0 ) ::madvise( const_cast<char *>( _data ), bytes, MADV_DONTNEED );
+
+  #else
+    (void) offset;                                                            // the copy is one allocation, it can't be released piecemeal
+  #endif
+}
@@ -0,0 +1,38 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <string>
+#include <string_view>
+
+
+
+
+// A read-only view of an entire file's bytes.  Where the operating system supports it (POSIX) the file is memory mapped, so its
+// bytes are paged in on demand and never copied;  elsewhere the file is read into memory once.  The mapping is released when the
+// object is destroyed (RAII).
+class MappedFile
+{
+  public:
+    explicit MappedFile( std::string const & filename );                     // is_open() reports whether the file could be opened
+
+    MappedFile            ( MappedFile && other ) noexcept;
+    MappedFile & operator=( MappedFile && rhs   ) & noexcept;
+    MappedFile            ( MappedFile const &  ) = delete;                   // intentionally prohibit making copies
+    MappedFile & operator=( MappedFile const &  ) = delete;                   // intentionally prohibit copy assignments
+   ~MappedFile() noexcept;
+
+    bool             is_open() const noexcept;
+    std::string_view bytes  () const noexcept;                                // the file's contents, valid for the lifetime of this object
+
+    void release_before( std::size_t offset ) noexcept;                       // the bytes before offset won't be needed again, so let the operating system reclaim the
+                                                                              // memory holding them.  They still read correctly if touched again, just slower
+
+  private:
+    void release() noexcept;
+
+    char const * _data   = nullptr;
+    std::size_t  _size   = 0;
+    bool         _open   = false;
+    bool         _mapped = false;                                             // true if _data must be unmapped, false if it points into _copy (or nowhere)
+    std::string  _copy;                                                       // the file's contents when it can't be mapped
+};
@@ -0,0 +1,65 @@
+#pragma once                                                                  // include guard
+
+#include <cmath>                                                              // llround(), isnan()
+#include <compare>                                                            // strong_ordering
+#include <cstdint>                                                            // int64_t
+#include <iostream>                                                           // istream, ostream
+
+
+
+
+// An amount of US money held exactly, as a whole number of cents.  Grocery prices are decimal amounts, and most of them (Ex: 10.79)
+// have no exact binary floating point representation, so a sum of doubles drifts and two prices can only be compared within an
+// epsilon.  Held in cents, sums are exact, comparisons are plain integer comparisons, and a column of prices adds up with integer
+// vector instructions.
+//
+// Amounts given in dollars are rounded to the nearest cent (halves away from zero), and amounts are written and read in dollars, so
+// text files and receipts are unchanged:  Money( 10.79 ) is 1079 cents, and dollars() is again exactly the double nearest 10.79.
+class Money
+{
+  public:
+    // Construction
+    constexpr Money() noexcept = default;                                     // $0.00
+    explicit  Money( double dollars ) noexcept : _cents( to_cents( dollars ) ) {}      // rounded to the nearest cent, NaN is $0.00
+    static constexpr Money from_cents( std::int64_t cents ) noexcept { Money money;  money._cents = cents;  return money; }
+
+    // Queries
+    constexpr std::int64_t cents  () const noexcept { return _cents;                               }
+    constexpr double       dollars() const noexcept { return static_cast<double>( _cents ) / 100.0; }
+
+    // Arithmetic, exact (barring overflow past about 92 quadrillion dollars)
+    constexpr Money & operator+=( Money rhs )             noexcept { _cents += rhs._cents;  return *this; }
+    constexpr Money & operator-=( Money rhs )             noexcept { _cents -= rhs._cents;  return *this; }
+    constexpr Money & operator*=( std::int64_t quantity ) noexcept { _cents *= quantity;    return *this; }
+
+    friend constexpr Money operator+( Money lhs, Money rhs )             noexcept { return lhs += rhs;      }
+    friend constexpr Money operator-( Money lhs, Money rhs )             noexcept { return lhs -= rhs;      }
+    friend constexpr Money operator*( Money lhs, std::int64_t quantity ) noexcept { return lhs *= quantity; }
+    friend constexpr Money operator*( std::int64_t quantity, Money rhs ) noexcept { return rhs *= quantity; }
+
+    // Relational Operators
+    constexpr auto operator<=>( Money const & ) const noexcept = default;
+
+    // Insertion and Extraction Operators, in dollars.  Output honors the stream's floating point format (Ex: std::fixed)
+    friend std::ostream & operator<<( std::ostream & stream, Money money ) { return stream << money.dollars(); }
+    friend std::istream & operator>>( std::istream & stream, Money & money )
+    {
+      double dollars;
+      if( stream >> dollars ) money = Money( dollars );
+      return stream;
+    }
+
+  private:
+    static std::int64_t to_cents( double dollars ) noexcept
+    {
+      constexpr double LIMIT = 9.2e18;                                        // just inside the range of std::int64_t
+      if( std::isnan( dollars ) ) return 0;
+
+      double const cents = dollars * 100.0;
+      return cents >=  LIMIT ?  static_cast<std::int64_t>(  LIMIT )
+           : cents <= -LIMIT ? -static_cast<std::int64_t>(  LIMIT )
+           :                    std::llround( cents );
+    }
+
+    std::int64_t _cents = 0;
+};
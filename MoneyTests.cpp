@@ -0,0 +1,131 @@
+#include <cstdint>                                                                          // int64_t
+#include <exception>
+#include <fstream>                                                                          // ifstream
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <limits>                                                                           // numeric_limits
+#include <sstream>                                                                          // istringstream, ostringstream
+#include <string>
+
+#include "CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "Money.hpp"
+
+
+
+
+
+namespace  // anonymous
+{
+  class MoneyRegressionTest
+  {
+    public:
+      MoneyRegressionTest();
+
+    private:
+      void tests();
+      void receipt();
+
+      Regression::CheckResults affirm;
+  } run_money_tests;
+
+
+
+
+  void MoneyRegressionTest::tests()
+  {
+    {  // Dollars round to the nearest cent, and back to the very same double
+      affirm.is_equal( "Money from dollars                                ", std::int64_t{ 1079 }, Money( 10.79 ).cents() );
+      affirm.is_equal( "Money to dollars                                  ", 10.79, Money( 10.79 ).dollars() );
+      affirm.is_equal( "Money rounds half away from zero                  ", std::int64_t{ -3 }, Money( -0.025 ).cents() );
+      affirm.is_equal( "Money rounds tiny errors away                     ", Money( 10.0 ), Money( 9.99999 ) );
+      affirm.is_equal( "Money NaN is zero                                 ", Money(), Money( std::numeric_limits<double>::quiet_NaN() ) );
+      affirm.is_true ( "Money infinity saturates                          ", Money( std::numeric_limits<double>::infinity() ) > Money( 1e15 ) );
+    }
+
+    {  // Sums are exact where doubles drift
+      Money  money;
+      double dollars = 0.0;
+      for( int i = 0; i < 1'000; ++i ) { money += Money( 0.10 );  dollars += 0.10; }
+
+      affirm.is_equal( "Money sum is exact                                ", Money::from_cents( 10'000 ), money );
+      affirm.is_true ( "Money sum of doubles drifts                       ", dollars != 100.0 );
+      affirm.is_equal( "Money arithmetic                                  ", Money( 7.47 ), Money( 10.00 ) - Money( 2.53 ) );
+      affirm.is_equal( "Money times quantity                              ", Money( 8.97 ), 3 * Money( 2.99 ) );
+    }
+
+    {  // Comparisons are exact, one cent apart is unequal
+      affirm.is_true ( "Money ordering                                    ", Money( 0.01 ) < Money( 0.02 ) && Money( -0.01 ) < Money() );
+      affirm.is_true ( "Money one cent apart                              ", Money( 10.00 ) != Money( 10.01 ) );
+    }
+
+    {  // Read what you write
+      std::stringstream stream;
+      stream << Money( 123.79 ) << ' ' << Money( -0.5 ) << " 12.345";
+
+      Money a, b, c;
+      stream >> a >> b >> c;
+      affirm.is_equal( "Money insertion and extraction 1                  ", Money( 123.79 ), a );
+      affirm.is_equal( "Money insertion and extraction 2                  ", Money( -0.5   ), b );
+      affirm.is_equal( "Money extraction rounds to the cent               ", std::int64_t{ 1235 }, c.cents() );
+    }
+  }
+
+
+
+
+  // Parity with the checkout's receipt in sample_output.txt:  the items listed add up, in cents, to the total printed, and print
+  // the same as they did when prices were doubles
+  void MoneyRegressionTest::receipt()
+  {
+    std::ifstream file( "sample_output.txt" );
+    if( !file ) return;
+
+    Money       total, printedTotal;
+    double      doubleTotal = 0.0;
+    std::string line;
+    while( std::getline( file, line ) )
+    {
+      std::istringstream stream( line );
+      if( GroceryItem item;  line.starts_with( '"' ) && stream >> item )
+      {
+        total       += item.exactPrice();
+        doubleTotal += item.price();
+      }
+      else if( line.starts_with( "Total  $" ) )
+      {
+        std::istringstream( line.substr( 8 ) ) >> printedTotal;
+      }
+    }
+
+    std::ostringstream printed, printedFromDoubles;
+    printed            << std::fixed << std::setprecision( 2 ) << total.dollars();
+    printedFromDoubles << std::fixed << std::setprecision( 2 ) << doubleTotal;
+
+    affirm.is_equal( "Money receipt total matches sample output         ", printedTotal, total );
+    affirm.is_equal( "Money receipt prints as it did with doubles       ", printedFromDoubles.str(), printed.str() );
+  }
+
+
+
+
+  MoneyRegressionTest::MoneyRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nMoney Regression Test:\n";
+      tests();
+      receipt();
+
+      std::clog << "\n\nMoney Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class Money\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
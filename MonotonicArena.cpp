@@ -0,0 +1,115 @@
+#include <cstddef>                                                            // size_t
+#include <memory_resource>                                                    // memory_resource, monotonic_buffer_resource
+#include <mutex>                                                              // scoped_lock
+
+#include "MonotonicArena.hpp"
+
+
+
+
+/*******************************************************************************
+**  Construction
+*******************************************************************************/
+
+// Constructor
+MonotonicArena::MonotonicArena( std::size_t initialBlockSize )
+  : _arena( initialBlockSize )
+{}
+
+
+
+
+// Worker constructor
+MonotonicArena::Worker::Worker( MonotonicArena & arena )
+  : _arena( arena ), _buffer( &arena )
+{}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// worker()
+std::pmr::memory_resource * MonotonicArena::worker()
+{
+  std::scoped_lock lock( _mutex );
+  return &_workers.emplace_back( *this );
+}
+
+
+
+
+// bytes_allocated()
+std::size_t MonotonicArena::bytes_allocated() const noexcept
+{
+  std::scoped_lock lock( _mutex );
+  return _bytesAllocated;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  std::pmr::memory_resource Overrides
+*******************************************************************************/
+
+// do_allocate()
+void * MonotonicArena::do_allocate( std::size_t bytes, std::size_t alignment )
+{
+  std::scoped_lock lock( _mutex );
+  _bytesAllocated += bytes;
+  return _arena.allocate( bytes, alignment );
+}
+
+
+
+
+// do_deallocate()
+void MonotonicArena::do_deallocate( void *, std::size_t, std::size_t )
+{}                                                                            // memory is reclaimed only when the arena is destroyed
+
+
+
+
+// do_is_equal()
+bool MonotonicArena::do_is_equal( std::pmr::memory_resource const & other ) const noexcept
+{
+  if( this == &other ) return true;
+  auto worker = dynamic_cast<Worker const *>( &other );
+  return worker != nullptr && &worker->_arena == this;
+}
+
+
+
+
+// Worker::do_allocate()
+void * MonotonicArena::Worker::do_allocate( std::size_t bytes, std::size_t alignment )
+{
+  return _buffer.allocate( bytes, alignment );                                // locks the arena only when the current block runs out
+}
+
+
+
+
+// Worker::do_deallocate()
+void MonotonicArena::Worker::do_deallocate( void *, std::size_t, std::size_t )
+{}                                                                            // memory is reclaimed only when the arena is destroyed
+
+
+
+
+// Worker::do_is_equal()
+bool MonotonicArena::Worker::do_is_equal( std::pmr::memory_resource const & other ) const noexcept
+{
+  return _arena.is_equal( other );
+}
@@ -0,0 +1,55 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <deque>
+#include <memory_resource>                                                    // memory_resource, monotonic_buffer_resource
+#include <mutex>
+
+
+
+
+// A thread safe monotonic arena:  allocations are carved one after another out of large blocks, deallocation does nothing, and all
+// the memory is released at once when the arena is destroyed.  It suits data that is bulk loaded once and lives as long as its
+// container, like a grocery item database's strings.  A std::pmr::monotonic_buffer_resource guarded by a mutex.
+//
+// Threads allocating heavily at the same time (Ex: the parallel loader's workers) would all queue on that mutex, so each can take a
+// worker() of its own instead:  a front end that carves allocations out of blocks it takes from the arena, locking the arena only to
+// take another block.  Workers live as long as the arena, so whatever they allocate does too, and they compare equal to the arena and
+// to each other, so memory from one may be handed to any of them.
+class MonotonicArena : public std::pmr::memory_resource
+{
+  public:
+    explicit MonotonicArena( std::size_t initialBlockSize = std::size_t{ 1 } << 16 );
+
+    MonotonicArena            ( MonotonicArena const & ) = delete;            // intentionally prohibit making copies
+    MonotonicArena & operator=( MonotonicArena const & ) = delete;            // intentionally prohibit copy assignments
+
+    std::pmr::memory_resource * worker();                                     // a new front end for one thread at a time, see above
+    std::size_t bytes_allocated() const noexcept;                             // total of all allocation requests, padding excluded.  Blocks
+                                                                              // taken by workers count whole
+  private:
+    class Worker final : public std::pmr::memory_resource
+    {
+      public:
+        explicit Worker( MonotonicArena & arena );
+
+      private:
+        friend class MonotonicArena;
+
+        void * do_allocate  ( std::size_t bytes, std::size_t alignment ) override;
+        void   do_deallocate( void * p, std::size_t bytes, std::size_t alignment ) override;
+        bool   do_is_equal  ( std::pmr::memory_resource const & other ) const noexcept override;
+
+        MonotonicArena &                    _arena;
+        std::pmr::monotonic_buffer_resource _buffer;                          // blocks come from _arena, and are never given back before it's destroyed
+    };
+
+    void * do_allocate  ( std::size_t bytes, std::size_t alignment ) override;
+    void   do_deallocate( void * p, std::size_t bytes, std::size_t alignment ) override;
+    bool   do_is_equal  ( std::pmr::memory_resource const & other ) const noexcept override;
+
+    mutable std::mutex                  _mutex;
+    std::pmr::monotonic_buffer_resource _arena;
+    std::size_t                         _bytesAllocated = 0;
+    std::deque<Worker>                  _workers;                             // a deque, so workers handed out never move.  Destroyed before _arena
+};
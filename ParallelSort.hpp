@@ -0,0 +1,74 @@
+#pragma once                                                                  // include guard
+
+#include <algorithm>                                                          // sort(), inplace_merge(), min()
+#include <cstddef>                                                            // size_t
+#include <exception>                                                          // exception_ptr, current_exception(), rethrow_exception()
+#include <iterator>                                                           // distance(), next()
+#include <mutex>
+#include <thread>                                                             // jthread
+#include <vector>
+
+
+
+
+// Sort [first, last) with up to threads worker threads:  each thread sorts one contiguous run with std::sort(), then the runs are
+// merged pairwise, the merges of each round in parallel, until one run remains.  The result is what std::sort( first, last, less )
+// would produce for a strict total order; for ties that are not identical, make less total (Ex: break ties by position) if the
+// order must not depend on the number of threads.
+//
+// The standard parallel algorithms (std::execution::par) would do, but libstdc++ implements them with Intel TBB, which would then
+// be required to build.  Any exception thrown by less is rethrown once every thread has stopped, leaving [first, last) in some
+// permutation of its original elements.
+template<typename RandomIt, typename Less>
+void parallel_sort( RandomIt first, RandomIt last, Less less, std::size_t threads = 1 )
+{
+  constexpr std::size_t MINIMUM_RUN = 1 << 14;                                // smaller runs aren't worth a thread
+
+  auto const size = static_cast<std::size_t>( std::distance( first, last ) );
+  threads = std::max<std::size_t>( 1, std::min( threads, size / MINIMUM_RUN ) );
+  if( threads == 1 )
+  {
+    std::sort( first, last, less );
+    return;
+  }
+
+  // Run i is [bounds[i], bounds[i+1])
+  std::vector<RandomIt> bounds;
+  for( std::size_t i = 0; i <= threads; ++i ) bounds.push_back( std::next( first, static_cast<std::ptrdiff_t>( size * i / threads ) ) );
+
+  std::exception_ptr failure;
+  std::mutex         failureMutex;
+  auto               guarded = [&]( auto && work )
+  {
+    try
+    {
+      work();
+    }
+    catch( ... )
+    {
+      std::scoped_lock lock( failureMutex );
+      if( !failure ) failure = std::current_exception();
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers;
+    for( std::size_t i = 1; i < threads; ++i ) workers.emplace_back( [&, i] { guarded( [&] { std::sort( bounds[i], bounds[i + 1], less ); } ); } );
+    guarded( [&] { std::sort( bounds[0], bounds[1], less ); } );              // the calling thread takes the first run
+  }                                                                           // jthreads join when destroyed
+
+  // Merge neighboring runs, halving the number of runs each round
+  for( std::size_t width = 1; width < threads && !failure; width *= 2 )
+  {
+    std::vector<std::jthread> workers;
+    for( std::size_t i = 0; i + width < threads; i += 2 * width )
+    {
+      auto const begin  = bounds[i];
+      auto const middle = bounds[i + width];
+      auto const end    = bounds[std::min( i + 2 * width, threads )];
+      workers.emplace_back( [&, begin, middle, end] { guarded( [&] { std::inplace_merge( begin, middle, end, less ); } ); } );
+    }
+  }
+
+  if( failure ) std::rethrow_exception( failure );
+}
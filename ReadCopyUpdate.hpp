@@ -0,0 +1,174 @@
+#pragma once                                                                  // include guard
+
+#include <array>
+#include <atomic>
+#include <cstddef>                                                            // size_t
+#include <memory>                                                             // unique_ptr, make_unique()
+#include <mutex>
+#include <thread>                                                             // this_thread::yield()
+#include <type_traits>                                                        // invoke_result_t, is_void_v
+#include <utility>                                                            // move(), exchange(), forward()
+
+
+
+
+// Read-copy-update protection for a value that many threads read and few threads replace.  Readers never lock and never wait:
+// read() pins the current version with one atomic increment and returns a guard, and the version stays valid until the guard is
+// destroyed.  A writer builds a complete new version off to the side and publishes it with one atomic pointer swap, then waits for
+// every reader still using the old version to finish before destroying it.  Readers that start after the swap see the new version
+// immediately, and no reader ever sees a version half updated.
+//
+// Readers are counted in a fixed array of per-thread-group counters, each on its own cache line, so readers on different cores
+// rarely touch the same memory.  Each counter comes in two halves, selected by the parity of a grace period number (sleepable RCU):
+// a writer flips the parity so new readers count themselves in the other half, and the half it waits on can only drain.
+template<typename T>
+class ReadCopyUpdate
+{
+  private:
+    static constexpr std::size_t SLOTS = 64;
+
+    struct alignas( 64 ) ReaderCount
+    {
+      std::atomic<std::size_t> active[2] = { 0, 0 };
+    };
+
+  public:
+    // Pins one version of the value for as long as it lives.  Move only.
+    class ReadGuard
+    {
+      public:
+        ReadGuard( ReadGuard && other ) noexcept : _value( std::exchange( other._value, nullptr ) ), _count( std::exchange( other._count, nullptr ) ) {}
+        ReadGuard & operator=( ReadGuard && ) = delete;
+        ReadGuard            ( ReadGuard const & ) = delete;
+        ReadGuard & operator=( ReadGuard const & ) = delete;
+       ~ReadGuard() noexcept { if( _count ) _count->fetch_sub( 1, std::memory_order_release ); }
+
+        T const * get       () const noexcept { return  _value; }
+        T const * operator->() const noexcept { return  _value; }
+        T const & operator* () const noexcept { return *_value; }
+
+      private:
+        friend class ReadCopyUpdate;
+        ReadGuard( T const * value, std::atomic<std::size_t> * count ) noexcept : _value( value ), _count( count ) {}
+
+        T const *                  _value;
+        std::atomic<std::size_t> * _count;
+    };
+
+
+
+    explicit ReadCopyUpdate( std::unique_ptr<T const> initial ) noexcept : _current( initial.release() ) {}
+
+    ReadCopyUpdate            ( ReadCopyUpdate const & ) = delete;            // intentionally prohibit making copies
+    ReadCopyUpdate & operator=( ReadCopyUpdate const & ) = delete;            // intentionally prohibit copy assignments
+
+   ~ReadCopyUpdate() noexcept                                                 // no reader may outlive the value it reads
+    {
+      delete _current.load();
+    }
+
+
+
+    // Pin and return the current version.  Wait-free:  a bounded number of steps no matter what writers or other readers do.
+    ReadGuard read() const noexcept
+    {
+      auto & count = _readers[slot()].active[_gracePeriod.load( std::memory_order_seq_cst ) & 1];
+      count.fetch_add( 1, std::memory_order_seq_cst );
+      return ReadGuard( _current.load( std::memory_order_seq_cst ), &count );
+    }
+
+
+
+    // Make next the current version, then wait until no reader can still be using the previous version and destroy it.  Writers are
+    // serialized with each other, never with readers.  Must not be called while the calling thread holds a ReadGuard.  published(),
+    // if given, runs right after the swap, still under the writer lock, so a writer can account for each version (Ex: count it) in
+    // the order versions are published.  It must not throw.
+    void publish( std::unique_ptr<T const> next )
+    {
+      publish( std::move( next ), [] {} );
+    }
+
+    template<typename Published>
+    void publish( std::unique_ptr<T const> next, Published && published )
+    {
+      std::scoped_lock lock( _writer );
+      install( std::move( next ), published );
+    }
+
+
+
+    // Copy the current version, let modify() change the copy, and publish it, all under the writer lock, so writers are serialized
+    // and no update is lost:  each copies the version the previous one published.  copy( T const & ) returns a std::unique_ptr<T>,
+    // for types copied some other way than by their copy constructor (Ex: a clone() member).  Returns whatever modify() returns.  If
+    // copy or modify throws, nothing is published.  Same rules as publish(), including published().
+    template<typename Copy, typename Modify, typename Published>
+    decltype( auto ) update( Copy && copy, Modify && modify, Published && published )
+    {
+      std::scoped_lock   lock( _writer );
+      std::unique_ptr<T> next = copy( *_current.load( std::memory_order_seq_cst ) );
+
+      if constexpr( std::is_void_v<std::invoke_result_t<Modify &, T &>> )
+      {
+        modify( *next );
+        install( std::move( next ), published );
+      }
+      else
+      {
+        auto result = modify( *next );
+        install( std::move( next ), published );
+        return result;
+      }
+    }
+
+    template<typename Copy, typename Modify>
+    decltype( auto ) update( Copy && copy, Modify && modify )
+    {
+      return update( std::forward<Copy>( copy ), std::forward<Modify>( modify ), [] {} );
+    }
+
+    template<typename Modify>
+    decltype( auto ) update( Modify && modify )
+    {
+      return update( []( T const & current ) { return std::make_unique<T>( current ); }, std::forward<Modify>( modify ) );
+    }
+
+
+
+  private:
+    // The reader counter this thread uses.  Threads are spread round robin over the slots the first time they read.
+    static std::size_t slot() noexcept
+    {
+      static std::atomic<std::size_t> nextSlot = 0;
+      thread_local std::size_t const  mySlot   = nextSlot.fetch_add( 1, std::memory_order_relaxed ) % SLOTS;
+      return mySlot;
+    }
+
+    // Swap in next, run published(), and destroy the previous version once no reader can still be using it.  The caller holds _writer.
+    template<typename Published>
+    void install( std::unique_ptr<T const> next, Published & published )
+    {
+      std::unique_ptr<T const> previous( _current.exchange( next.release(), std::memory_order_seq_cst ) );
+      published();
+      synchronize();
+    }
+
+    // Wait for a grace period:  every reader that might have loaded the previous version has released it.  A reader that picked up
+    // the parity just before a flip may still count itself under the old parity after the flip, so both halves are drained, each
+    // after a flip that steers new readers away from it.
+    void synchronize() const noexcept
+    {
+      for( int pass = 0; pass < 2; ++pass )
+      {
+        auto const parity = _gracePeriod.fetch_add( 1, std::memory_order_seq_cst ) & 1;
+        for( auto & readers : _readers )
+        {
+          while( readers.active[parity].load( std::memory_order_seq_cst ) != 0 ) std::this_thread::yield();
+        }
+      }
+    }
+
+    std::atomic<T const *>                     _current;
+    mutable std::atomic<std::size_t>           _gracePeriod = 0;
+    mutable std::array<ReaderCount, SLOTS>     _readers;
+    std::mutex                                 _writer;
+};
@@ -0,0 +1,67 @@
+#include <array>
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint64_t
+#include <optional>
+#include <stdexcept>                                                          // invalid_argument
+#include <string>
+#include <string_view>
+
+#include "Upc.hpp"
+
+
+
+
+/*******************************************************************************
+**  Construction
+*******************************************************************************/
+
+// Construct from a string of digits
+Upc::Upc( std::string_view digits )
+{
+  auto upc = parse( digits );
+  if( !upc ) throw std::invalid_argument( "Error - Invalid argument:  \"" + std::string( digits ) + "\" is not a valid UPC" );
+  _key = upc->_key;
+}
+
+
+
+
+// parse()
+std::optional<Upc> Upc::parse( std::string_view digits ) noexcept
+{
+  if( digits.empty() || digits.size() > MAX_DIGITS ) return std::nullopt;
+
+  std::uint64_t value = 0;
+  for( char c : digits )
+  {
+    if( c < '0' || c > '9' ) return std::nullopt;
+    value = value * 10 + static_cast<std::uint64_t>( c - '0' );
+  }
+
+  return Upc( std::uint64_t{ digits.size() } << LENGTH_SHIFT | value );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// to_string()
+std::string Upc::to_string() const
+{
+  std::array<char, MAX_DIGITS> digits;
+  auto                         n = value();
+
+  for( auto i = length(); i > 0; --i )
+  {
+    digits[i - 1] = static_cast<char>( '0' + n % 10 );
+    n /= 10;
+  }
+  return std::string( digits.data(), length() );
+}
@@ -0,0 +1,48 @@
+#pragma once                                                                  // include guard
+
+#include <compare>                                                            // strong_ordering
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint64_t
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+
+
+// A Universal Product Code packed into a single 64-bit integer.  UPCs in the grocery item database are 11 to 14 decimal digits
+// (Ex: 051600080015, 05017402006207) where leading zeros are significant, so both the digits' value and the number of digits are
+// kept:
+//
+//      bits 63..62    61..57            56..0
+//           unused    number of digits  numeric value of the digits
+//
+// Two UPCs are equal if and only if their packed keys are equal, and a valid key is never zero, so zero is free to mark an empty
+// slot in a hash table.  Keys order by length and then value, which is NOT the lexicographic order of the UPC strings.
+class Upc
+{
+  public:
+    static constexpr std::size_t MAX_DIGITS = 17;                             // 10^17 < 2^57, so the value fits beneath the length bits
+
+    // Construction
+    explicit Upc( std::string_view digits );                                  // throws std::invalid_argument if digits is not a valid UPC
+    static std::optional<Upc> parse( std::string_view digits ) noexcept;      // returns nullopt if digits is not a valid UPC (empty, too long, or not all digits)
+    static constexpr Upc      from_key( std::uint64_t key ) noexcept { return Upc( key ); }   // key must have come from key() of a valid Upc
+
+    // Queries
+    constexpr std::uint64_t key   () const noexcept { return _key;                         }
+    constexpr std::size_t   length() const noexcept { return _key >> LENGTH_SHIFT;         }
+    constexpr std::uint64_t value () const noexcept { return _key & ( VALUE_BIT - 1 );     }
+    std::string             to_string() const;                                // canonical form, with leading zeros restored
+
+    // Relational Operators
+    constexpr auto operator<=>( Upc const & ) const noexcept = default;
+
+  private:
+    static constexpr unsigned      LENGTH_SHIFT = 57;
+    static constexpr std::uint64_t VALUE_BIT    = std::uint64_t{ 1 } << LENGTH_SHIFT;
+
+    constexpr Upc( std::uint64_t key ) noexcept : _key( key ) {}
+
+    std::uint64_t _key;
+};
@@ -0,0 +1,139 @@
+#include <algorithm>                                                          // max()
+#include <bit>                                                                // bit_ceil()
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t, uint64_t
+
+#if defined( __AVX2__ )
+  #include <immintrin.h>                                                      // _mm256_mullo_epi32(), _mm256_testc_si256(), ...
+#endif
+
+#include "Hash.hpp"
+#include "Upc.hpp"
+#include "UpcFilter.hpp"
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  constexpr std::size_t BITS_PER_BLOCK = 256;
+
+  // Odd multipliers, one per word of a block.  Word i gets the bit selected by the top five bits of low * SALTS[i].  (The same
+  // constants as Apache Parquet's and Impala's split block Bloom filters.)
+  constexpr std::uint32_t SALTS[8] = { 0x47B6137BU, 0x44974D91U, 0x8824AD5BU, 0xA2B7289DU, 0x705495C7U, 0x2DF1424BU, 0x9EFC4947U, 0x5C6BFB31U };
+
+  #if defined( __AVX2__ )
+    inline __m256i bits_of( std::uint32_t low ) noexcept
+    {
+      auto const salts   = _mm256_loadu_si256( reinterpret_cast<__m256i const *>( SALTS ) );
+      auto const indexes = _mm256_srli_epi32( _mm256_mullo_epi32( _mm256_set1_epi32( static_cast<int>( low ) ), salts ), 27 );
+      return _mm256_sllv_epi32( _mm256_set1_epi32( 1 ), indexes );
+    }
+  #else
+    constexpr std::uint32_t bit_of( std::uint32_t low, std::size_t word ) noexcept
+    {
+      return std::uint32_t{ 1 } << ( ( low * SALTS[word] ) >> 27 );
+    }
+  #endif
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+// Construct for an expected number of UPCs
+UpcFilter::UpcFilter( std::size_t expectedUpcs )
+  : _blocks( std::bit_ceil( std::max<std::size_t>( 1, expectedUpcs * BITS_PER_UPC / BITS_PER_BLOCK ) ), Block{} )
+{}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// might_contain()
+bool UpcFilter::might_contain( Upc upc ) const noexcept
+{
+  if( _blocks.empty() ) return true;
+
+  // Packed UPCs are highly regular, so they're scrambled before the high half picks a block and the low half picks bits within it
+  auto const   hash  = hash_of( upc.key() );
+  auto const   low   = static_cast<std::uint32_t>( hash );
+  auto const & block = _blocks[block_of( hash )];
+
+  #if defined( __AVX2__ )
+    // Every wanted bit is set when none of them is missing from the block
+    return _mm256_testc_si256( _mm256_load_si256( reinterpret_cast<__m256i const *>( block.words ) ), bits_of( low ) );
+  #else
+    for( std::size_t word = 0; word < 8; ++word ) if( ( block.words[word] & bit_of( low, word ) ) == 0 ) return false;
+    return true;
+  #endif
+}
+
+
+
+
+// size_bytes()
+std::size_t UpcFilter::size_bytes() const noexcept
+{
+  return _blocks.size() * sizeof( Block );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// insert()
+void UpcFilter::insert( Upc upc ) noexcept
+{
+  if( _blocks.empty() ) return;
+
+  auto const hash  = hash_of( upc.key() );
+  auto const low   = static_cast<std::uint32_t>( hash );
+  auto &     block = _blocks[block_of( hash )];
+
+  #if defined( __AVX2__ )
+    auto const words = reinterpret_cast<__m256i *>( block.words );
+    _mm256_store_si256( words, _mm256_or_si256( _mm256_load_si256( words ), bits_of( low ) ) );
+  #else
+    for( std::size_t word = 0; word < 8; ++word ) block.words[word] |= bit_of( low, word );
+  #endif
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private Helpers
+*******************************************************************************/
+
+// block_of()
+std::size_t UpcFilter::block_of( std::uint64_t hash ) const noexcept
+{
+  return ( hash >> 32 ) & ( _blocks.size() - 1 );
+}
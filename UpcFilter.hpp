@@ -0,0 +1,44 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t
+#include <vector>
+
+#include "Upc.hpp"
+
+
+
+
+// A compact, probabilistic set of UPCs (a split block Bloom filter) that answers "definitely not present" or "might be present".
+// It never forgets a UPC it was given, so a UPC it rejects is certainly absent, but it may accept a UPC it was never given (a false
+// positive), at a rate that grows as more UPCs are added than it was sized for.
+//
+// Each UPC sets one bit in each of the eight 32-bit words of a single 32-byte block, so a query touches one cache line and, with
+// AVX2, tests all eight bits with a handful of instructions.  At BITS_PER_UPC the false positive rate is well under 1%.  UPCs can't
+// be removed; a filter over a shrinking set is rebuilt from scratch instead.
+class UpcFilter
+{
+  public:
+    static constexpr std::size_t BITS_PER_UPC = 16;                           // bits of filter per UPC it is sized for
+
+    // Constructors
+    UpcFilter() = default;                                                    // an empty filter.  Never sized, it rejects nothing
+    explicit UpcFilter( std::size_t expectedUpcs );                           // sized for expectedUpcs, accepting nothing until UPCs are inserted
+
+    // Queries
+    bool        might_contain( Upc upc ) const noexcept;                      // false only if upc was never inserted
+    std::size_t size_bytes   () const noexcept;                               // memory held by the filter
+
+    // Modifiers
+    void insert( Upc upc ) noexcept;                                          // has no effect on an empty filter, which accepts everything anyway
+
+  private:
+    struct alignas( 32 ) Block
+    {
+      std::uint32_t words[8];
+    };
+
+    std::size_t block_of( std::uint64_t hash ) const noexcept;                // the block a UPC with this hash sets bits in
+
+    std::vector<Block> _blocks;                                               // size is zero or a power of two
+};
@@ -0,0 +1,435 @@
+#include <algorithm>                                                          // max(), min()
+#include <bit>                                                                // bit_ceil(), countr_zero(), has_single_bit()
+#include <cstddef>                                                            // size_t, ptrdiff_t
+#include <cstdint>                                                            // uint32_t, uint64_t
+#include <span>
+#include <stdexcept>                                                          // invalid_argument
+#include <string_view>
+#include <utility>                                                            // move()
+#include <vector>
+
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+  #include <immintrin.h>                                                      // _mm256_cmpeq_epi64(), _mm_cmpeq_epi32(), ...
+#endif
+
+#include "GroceryItem.hpp"
+#include "Hash.hpp"
+#include "Upc.hpp"
+#include "UpcFilter.hpp"
+#include "UpcIndex.hpp"
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // The table is kept at most half full.  With groups of four slots compared at once, a miss at 50% occupancy almost always ends in
+  // the first group examined.
+  constexpr std::size_t MINIMUM_CAPACITY = 16;
+
+  constexpr std::size_t capacity_for( std::size_t count ) noexcept
+  {
+    return std::bit_ceil( std::max( MINIMUM_CAPACITY, count * 2 ) );
+  }
+
+
+
+  // Compare all four keys of a group against key and against the empty key.  Bit i of match (vacant) is set if group[i] equals key
+  // (is empty).
+  struct GroupMasks
+  {
+    unsigned match;
+    unsigned vacant;
+  };
+
+  inline GroupMasks compare_group( std::uint64_t const * group, std::uint64_t key ) noexcept
+  {
+    #if defined( __AVX2__ )
+      auto const keys   = _mm256_loadu_si256( reinterpret_cast<__m256i const *>( group ) );
+      auto const match  = _mm256_cmpeq_epi64( keys, _mm256_set1_epi64x( static_cast<long long>( key ) ) );
+      auto const vacant = _mm256_cmpeq_epi64( keys, _mm256_setzero_si256()                              );
+      return { static_cast<unsigned>( _mm256_movemask_pd( _mm256_castsi256_pd( match  ) ) ),
+               static_cast<unsigned>( _mm256_movemask_pd( _mm256_castsi256_pd( vacant ) ) ) };
+
+    #elif defined( __SSE2__ )
+      // SSE2 has no 64-bit compare, so compare 32-bit halves and require both halves of a lane to match
+      auto const wanted = _mm_set1_epi64x( static_cast<long long>( key ) );
+      auto const zero   = _mm_setzero_si128();
+      auto equal64 = []( __m128i a, __m128i b )
+      {
+        auto const halves = _mm_cmpeq_epi32( a, b );
+        return _mm_movemask_pd( _mm_castsi128_pd( _mm_and_si128( halves, _mm_shuffle_epi32( halves, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) ) );
+      };
+      auto const low  = _mm_loadu_si128( reinterpret_cast<__m128i const *>( group     ) );
+      auto const high = _mm_loadu_si128( reinterpret_cast<__m128i const *>( group + 2 ) );
+      return { static_cast<unsigned>( equal64( low, wanted ) | equal64( high, wanted ) << 2 ),
+               static_cast<unsigned>( equal64( low, zero   ) | equal64( high, zero   ) << 2 ) };
+
+    #else
+      GroupMasks masks{ 0, 0 };
+      for( unsigned i = 0; i < 4; ++i )
+      {
+        masks.match  |= static_cast<unsigned>( group[i] == key ) << i;
+        masks.vacant |= static_cast<unsigned>( group[i] == 0   ) << i;
+      }
+      return masks;
+    #endif
+  }
+
+
+
+  // Ask for the cache line holding address to be loaded, without waiting for it
+  inline void prefetch( void const * address ) noexcept
+  {
+    #if defined( __GNUC__ ) || defined( __clang__ )
+      __builtin_prefetch( address );
+    #elif defined( __SSE2__ )
+      _mm_prefetch( static_cast<char const *>( address ), _MM_HINT_T0 );
+    #else
+      (void) address;
+    #endif
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+// Construct from a data store
+UpcIndex::UpcIndex( std::vector<GroceryItem> const & dataStore )
+{
+  rehash( dataStore.size() );
+  for( std::size_t position = 0; position < dataStore.size(); ++position ) insert( dataStore, position );
+}
+
+
+
+
+// Adopt a prebuilt table
+UpcIndex::UpcIndex( std::vector<std::uint64_t> keys, std::vector<std::uint32_t> positions, std::vector<std::uint32_t> unpacked, std::size_t dataStoreSize )
+  : _keys( std::move( keys ) ), _positions( std::move( positions ) ), _unpacked( std::move( unpacked ) )
+{
+  bool valid = _keys.size() == _positions.size()  &&  ( _keys.empty() || ( std::has_single_bit( _keys.size() ) && _keys.size() >= GROUP_SIZE ) );
+
+  for( std::size_t i = 0; valid && i < _keys.size(); ++i )
+  {
+    if( _keys[i] == EMPTY     ) continue;
+    if( _keys[i] == TOMBSTONE ) { ++_tombstones;  continue; }
+    valid = _positions[i] < dataStoreSize;
+    ++_size;
+  }
+  valid = valid && ( _keys.empty() || _size + _tombstones < _keys.size() );   // a probe ends only at a match or an empty slot, so there must be an empty slot
+
+  for( auto position : _unpacked ) valid = valid && position < dataStoreSize;
+  _size += _unpacked.size();
+
+  if( !valid ) throw std::invalid_argument( "Error - Invalid argument:  malformed UPC index table" );
+
+  // The filter isn't persisted, it's rebuilt from the table's keys
+  _filter = UpcFilter( _keys.size() / 2 );
+  for( auto key : _keys ) if( key != EMPTY && key != TOMBSTONE ) _filter.insert( Upc::from_key( key ) );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// find( Upc )
+std::size_t UpcIndex::find( Upc upc ) const noexcept
+{
+  if( _keys.size() <= SCAN_CAPACITY ) return scan( upc.key() );
+  if( !_filter.might_contain( upc )  ) return npos;
+
+  auto const slot = slot_of( upc.key() );
+  return _keys[slot] == EMPTY ? npos : _positions[slot];
+}
+
+
+
+
+// find( data store, string )
+std::size_t UpcIndex::find( std::vector<GroceryItem> const & dataStore, std::string_view upc ) const noexcept
+{
+  if( auto packed = Upc::parse( upc ) ) return find( *packed );
+
+  for( auto position : _unpacked ) if( dataStore[position].upcCode() == upc ) return position;
+  return npos;
+}
+
+
+
+
+// find_many()
+std::vector<std::size_t> UpcIndex::find_many( std::span<Upc const> upcs ) const
+{
+  // Looked up one at a time, each probe waits on a cache miss before the next can begin.  Instead, hash a few UPCs ahead and prefetch
+  // their groups, so while one UPC is probed the groups of the next several are already on their way into the cache.
+  constexpr std::size_t PREFETCH_DISTANCE = 8;
+
+  std::vector<std::size_t> positions( upcs.size(), npos );
+  if( _keys.empty() ) return positions;
+
+  // Each UPC's group is computed once, when it is prefetched, and remembered until it is probed
+  std::size_t groups[PREFETCH_DISTANCE];
+  auto fetch = [&]( std::size_t i )
+  {
+    auto const group = groups[i % PREFETCH_DISTANCE] = group_of( upcs[i].key() );
+    prefetch( &_keys     [group * GROUP_SIZE] );
+    prefetch( &_positions[group * GROUP_SIZE] );
+  };
+
+  for( std::size_t i = 0; i < std::min( PREFETCH_DISTANCE, upcs.size() ); ++i ) fetch( i );
+
+  for( std::size_t i = 0; i < upcs.size(); ++i )
+  {
+    auto const slot = slot_of( upcs[i].key(), groups[i % PREFETCH_DISTANCE] );
+    if( _keys[slot] != EMPTY ) positions[i] = _positions[slot];
+
+    if( i + PREFETCH_DISTANCE < upcs.size() ) fetch( i + PREFETCH_DISTANCE );
+  }
+
+  return positions;
+}
+
+
+
+
+// size()
+std::size_t UpcIndex::size() const noexcept
+{
+  return _size;
+}
+
+
+
+
+// capacity()
+std::size_t UpcIndex::capacity() const noexcept
+{
+  return _keys.size();
+}
+
+
+
+
+// keys()
+std::vector<std::uint64_t> const & UpcIndex::keys() const noexcept
+{
+  return _keys;
+}
+
+
+
+
+// positions()
+std::vector<std::uint32_t> const & UpcIndex::positions() const noexcept
+{
+  return _positions;
+}
+
+
+
+
+// unpacked()
+std::vector<std::uint32_t> const & UpcIndex::unpacked() const noexcept
+{
+  return _unpacked;
+}
+
+
+
+
+// filter()
+UpcFilter const & UpcIndex::filter() const noexcept
+{
+  return _filter;
+}
+
+
+
+
+// scan()
+std::size_t UpcIndex::scan( std::uint64_t key ) const noexcept
+{
+  static_assert( SCAN_CAPACITY <= 64, "matches has one bit per slot" );
+
+  // Compare every group, with no hash to compute and no branch until the end.  Neither an empty slot nor a tombstone ever equals a
+  // packed UPC, so at most one bit of matches is set.
+  std::uint64_t matches = 0;
+  for( std::size_t base = 0; base < _keys.size(); base += GROUP_SIZE ) matches |= std::uint64_t{ compare_group( &_keys[base], key ).match } << base;
+
+  return matches == 0 ? npos : _positions[static_cast<std::size_t>( std::countr_zero( matches ) )];
+}
+
+
+
+
+// group_of()
+std::size_t UpcIndex::group_of( std::uint64_t key ) const noexcept
+{
+  // Packed UPCs are highly regular (same length, nearby values), so they're scrambled before the low bits pick a group
+  return hash_of( key ) & ( _keys.size() / GROUP_SIZE - 1 );
+}
+
+
+
+
+// slot_of()
+std::size_t UpcIndex::slot_of( std::uint64_t key ) const noexcept
+{
+  return slot_of( key, group_of( key ) );
+}
+
+
+
+
+// slot_of( key, group )
+std::size_t UpcIndex::slot_of( std::uint64_t key, std::size_t group ) const noexcept
+{
+  // Slots fill front to back within a group, so a group's empty slots all follow its occupied slots.  A matching key therefore
+  // always precedes the first empty slot, and a group with an empty slot ends the search.
+  auto const groupMask = _keys.size() / GROUP_SIZE - 1;
+
+  for( ;  ;  group = ( group + 1 ) & groupMask )
+  {
+    auto const base  = group * GROUP_SIZE;
+    auto const masks = compare_group( &_keys[base], key );
+
+    if( masks.match  != 0 ) return base + static_cast<std::size_t>( std::countr_zero( masks.match  ) );
+    if( masks.vacant != 0 ) return base + static_cast<std::size_t>( std::countr_zero( masks.vacant ) );
+  }
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// insert()
+bool UpcIndex::insert( std::vector<GroceryItem> const & dataStore, std::size_t position )
+{
+  auto const & upc    = dataStore[position].upcCode();
+  auto const   packed = Upc::parse( upc );
+
+  if( !packed )
+  {
+    for( auto p : _unpacked ) if( dataStore[p].upcCode() == upc ) return false;
+    _unpacked.push_back( static_cast<std::uint32_t>( position ) );
+    ++_size;
+    return true;
+  }
+
+  if( ( _size + _tombstones + 1 ) * 2 > _keys.size() ) rehash( _size + 1 );
+
+  auto const slot = slot_of( packed->key() );
+  if( _keys[slot] != EMPTY ) return false;
+
+  _keys     [slot] = packed->key();
+  _positions[slot] = static_cast<std::uint32_t>( position );
+  _filter.insert( *packed );
+  ++_size;
+  return true;
+}
+
+
+
+
+// erase()
+bool UpcIndex::erase( std::vector<GroceryItem> const & dataStore, std::size_t position )
+{
+  auto const slot = slot_at( dataStore, position );
+  if( slot == npos ) return false;
+
+  if( Upc::parse( dataStore[position].upcCode() ) )
+  {
+    _keys[slot] = TOMBSTONE;
+    ++_tombstones;
+  }
+  else _unpacked.erase( _unpacked.begin() + static_cast<std::ptrdiff_t>( slot ) );
+
+  --_size;
+  return true;
+}
+
+
+
+
+// relocate()
+void UpcIndex::relocate( std::vector<GroceryItem> const & dataStore, std::size_t from, std::size_t to )
+{
+  auto const slot = slot_at( dataStore, from );
+  if( slot == npos ) return;
+
+  if( Upc::parse( dataStore[from].upcCode() ) ) _positions[slot] = static_cast<std::uint32_t>( to );
+  else                                          _unpacked [slot] = static_cast<std::uint32_t>( to );
+}
+
+
+
+
+// slot_at()
+std::size_t UpcIndex::slot_at( std::vector<GroceryItem> const & dataStore, std::size_t position ) const noexcept
+{
+  // For an unpacked UPC, the "slot" is where position appears within _unpacked
+  auto const packed = Upc::parse( dataStore[position].upcCode() );
+  if( !packed )
+  {
+    for( std::size_t i = 0; i < _unpacked.size(); ++i ) if( _unpacked[i] == position ) return i;
+    return npos;
+  }
+
+  if( _keys.empty() ) return npos;
+  auto const slot = slot_of( packed->key() );
+  return _keys[slot] != EMPTY && _positions[slot] == position ? slot : npos;
+}
+
+
+
+
+// rehash()
+void UpcIndex::rehash( std::size_t count )
+{
+  // Rebuilding at the same capacity is worth it when it clears tombstones
+  auto const newCapacity = std::max( capacity_for( count ), _keys.size() );
+  if( newCapacity == _keys.size() && _tombstones == 0 ) return;
+
+  std::vector<std::uint64_t> keys     ( newCapacity, EMPTY );
+  std::vector<std::uint32_t> positions( newCapacity        );
+  keys     .swap( _keys      );
+  positions.swap( _positions );
+
+  // Entries already in the table are known to be unique, so each lands in the empty slot slot_of() finds for it.  The filter is
+  // sized for the most UPCs the new table will hold before it's rehashed again, and forgets the erased ones.
+  _tombstones = 0;
+  _filter     = UpcFilter( newCapacity / 2 );
+  for( std::size_t i = 0; i < keys.size(); ++i )
+  {
+    if( keys[i] == EMPTY || keys[i] == TOMBSTONE ) continue;
+
+    auto const slot = slot_of( keys[i] );
+    _keys     [slot] = keys[i];
+    _positions[slot] = positions[i];
+    _filter.insert( Upc::from_key( keys[i] ) );
+  }
+}
@@ -0,0 +1,84 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t, uint64_t
+#include <limits>                                                             // numeric_limits
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "Upc.hpp"
+#include "UpcFilter.hpp"
+
+
+
+
+// Open-addressing hash index mapping a UPC to the position of its grocery item within a data store.  The index does not own the
+// grocery items, it only remembers where they are.
+//
+// UPCs are stored as packed 64-bit keys (see class Upc) so a probe compares integers, never strings, and never touches the data
+// store.  Slots are probed a group at a time, with SIMD comparing every key in the group against the wanted key (and against the
+// empty key) at once.  A grocery item whose UPC is not all digits can't be packed; those rare items are kept aside and searched by
+// string comparison.
+//
+// A table of no more than SCAN_CAPACITY slots (a catalog of a handful of items) is scanned whole instead:  comparing every group,
+// without a hash to compute or a branch to mispredict, is quicker than hashing the UPC to probe just one of them.
+//
+// A miss is answered by a small Bloom filter (see class UpcFilter) in front of the table whenever it can be, so looking up a UPC
+// that isn't in the catalog (Ex: a shopper's own product at checkout) rarely touches the much larger table at all.  The filter is
+// sized along with the table and rebuilt whenever the table is.
+//
+// Erasing a UPC leaves a tombstone in its slot, so probes for other UPCs still walk past it.  Tombstones are never reused, they
+// are cleared when the table is next rehashed (or the index is rebuilt from its data store).
+class UpcIndex
+{
+  public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();  // returned by find() when the UPC is not indexed
+
+    // Constructors
+    UpcIndex() = default;                                                     // an empty index, finds nothing
+    explicit UpcIndex( std::vector<GroceryItem> const & dataStore );         // index every item in dataStore.  When UPCs repeat, the first one wins
+    UpcIndex( std::vector<std::uint64_t> keys,                                // adopt a previously built table (see keys(), positions(), unpacked()) without rehashing.
+              std::vector<std::uint32_t> positions,                           // Throws std::invalid_argument if the table is malformed or refers to a position at or
+              std::vector<std::uint32_t> unpacked,                            // beyond dataStoreSize
+              std::size_t                dataStoreSize );
+
+    // Queries
+    std::size_t find( Upc upc ) const noexcept;                                                             // position of upc, npos if not found
+    std::size_t find( std::vector<GroceryItem> const & dataStore, std::string_view upc ) const noexcept;   // position of upc within dataStore, npos if not found
+    std::vector<std::size_t> find_many( std::span<Upc const> upcs ) const;                                  // position of each upc, in order, npos for each not found
+    std::size_t size    () const noexcept;                                    // number of UPCs indexed
+    std::size_t capacity() const noexcept;                                    // number of slots in the table
+    UpcFilter const & filter() const noexcept;                                // the filter screening find( Upc ) for misses
+
+    std::vector<std::uint64_t> const & keys     () const noexcept;            // the raw table, for persisting a prebuilt index
+    std::vector<std::uint32_t> const & positions() const noexcept;
+    std::vector<std::uint32_t> const & unpacked () const noexcept;
+
+    // Modifiers
+    bool insert  ( std::vector<GroceryItem> const & dataStore, std::size_t position );                 // index dataStore[position], returns false if its UPC is already indexed
+    bool erase   ( std::vector<GroceryItem> const & dataStore, std::size_t position );                 // un-index dataStore[position], returns false if it wasn't indexed there
+    void relocate( std::vector<GroceryItem> const & dataStore, std::size_t from, std::size_t to );     // dataStore[from] is about to move to position to, the index follows it
+
+  private:
+    static constexpr std::size_t   GROUP_SIZE = 4;                            // slots compared per probe step, one 256-bit vector of keys
+    static constexpr std::uint64_t EMPTY      = 0;                            // a packed Upc key is never zero
+    static constexpr std::uint64_t TOMBSTONE  = ~std::uint64_t{ 0 };          // nor does it ever have all its length bits set
+    static constexpr std::size_t   SCAN_CAPACITY = 16;                        // tables this small are scanned whole rather than hashed.  At most 64
+
+    std::size_t scan    ( std::uint64_t key ) const noexcept;                 // position of key found by comparing every slot, npos if not found
+    std::size_t group_of( std::uint64_t key ) const noexcept;                 // the group where the search for key begins
+    std::size_t slot_of ( std::uint64_t key ) const noexcept;                 // the slot holding key, or the empty slot where it belongs
+    std::size_t slot_of ( std::uint64_t key, std::size_t group ) const noexcept;   // same, with the search beginning at group
+    std::size_t slot_at ( std::vector<GroceryItem> const & dataStore, std::size_t position ) const noexcept;   // the slot (or unpacked entry) indexing
+                                                                                                               // dataStore[position] there, npos if none
+    void        rehash ( std::size_t count );                                 // grow (or clear tombstones) so count UPCs fit without exceeding the maximum load factor
+
+    std::vector<std::uint64_t> _keys;                                         // packed UPCs, EMPTY if the slot is unused.  Size is zero or a power of two, and at least GROUP_SIZE
+    std::vector<std::uint32_t> _positions;                                    // _positions[i] is where the item with _keys[i] lives in the data store
+    std::vector<std::uint32_t> _unpacked;                                     // positions of items whose UPC isn't all digits, in data store order
+    std::size_t                _size       = 0;
+    std::size_t                _tombstones = 0;                              // slots whose UPC was erased, still occupied as far as probes are concerned
+    UpcFilter                  _filter;                                       // every packed UPC in the table, and those erased since the last rehash
+};
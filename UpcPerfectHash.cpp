@@ -0,0 +1,279 @@
+#include <algorithm>                                                          // sort(), stable_sort(), unique(), equal(), find()
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t, uint64_t
+#include <limits>                                                             // numeric_limits
+#include <optional>
+#include <stdexcept>                                                          // invalid_argument, length_error, runtime_error
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "Hash.hpp"
+#include "Upc.hpp"
+#include "UpcPerfectHash.hpp"
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  constexpr std::size_t   BUCKET_SIZE   = 4;                                  // average UPCs per bucket
+  constexpr std::size_t   SLACK         = 99;                                 // one extra slot per SLACK UPCs
+  constexpr std::uint32_t MAXIMUM_PILOT = 1 << 20;                            // give up on a seed whose pilots run this high
+  constexpr int           MAXIMUM_SEEDS = 16;
+
+  // The high half of hash scaled onto [0, buckets), without a division
+  constexpr std::size_t bucket_of( std::uint64_t hash, std::size_t buckets ) noexcept
+  {
+    return static_cast<std::size_t>( ( ( hash >> 32 ) * buckets ) >> 32 );
+  }
+
+
+
+  // The slot, before remapping, in a table of tableSize slots.  This has to be a remainder rather than a scaling of the high bits:
+  // the XOR keeps any high bits two UPCs share, so scaled they'd collide whatever the pilot, but it changes their low bits.
+  constexpr std::size_t raw_slot_of( std::uint64_t hash, std::uint32_t pilot, std::size_t tableSize ) noexcept
+  {
+    return static_cast<std::size_t>( ( hash ^ hash_of( pilot ) ) % tableSize );
+  }
+
+
+
+  struct Entry
+  {
+    std::uint64_t key;
+    std::uint32_t position;
+  };
+
+  // Every packed UPC in the data store with its position, sorted by UPC.  When a UPC repeats only its first position is kept, as
+  // UpcIndex keeps it, so a frozen database finds the same item an unfrozen one does.
+  std::vector<Entry> packed_entries( std::vector<GroceryItem> const & dataStore )
+  {
+    if( dataStore.size() > std::numeric_limits<std::uint32_t>::max() ) throw std::length_error( "Too many grocery items to hash" );
+
+    std::vector<Entry> entries;
+    entries.reserve( dataStore.size() );
+    for( std::size_t position = 0; position < dataStore.size(); ++position )
+    {
+      if( auto upc = Upc::parse( dataStore[position].upcCode() ) ) entries.push_back( { upc->key(), static_cast<std::uint32_t>( position ) } );
+    }
+
+    auto const byKey   = []( Entry const & lhs, Entry const & rhs ) { return lhs.key <  rhs.key; };
+    auto const sameKey = []( Entry const & lhs, Entry const & rhs ) { return lhs.key == rhs.key; };
+    std::stable_sort( entries.begin(), entries.end(), byKey );                // positions stay ascending within a key, so the first comes first
+    entries.erase( std::unique( entries.begin(), entries.end(), sameKey ), entries.end() );
+    return entries;
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+// Construct from a data store
+UpcPerfectHash::UpcPerfectHash( std::vector<GroceryItem> const & dataStore )
+{
+  auto const entries = packed_entries( dataStore );
+  auto const n       = entries.size();
+  if( n == 0 ) return;
+
+  auto const tableSize   = n + ( n + SLACK - 1 ) / SLACK;
+  auto const bucketCount = ( n + BUCKET_SIZE - 1 ) / BUCKET_SIZE;
+
+  // Almost every seed works the first time.  A seed fails only if some bucket can't be placed at all, and another seed reshuffles
+  // every bucket.
+  for( int attempt = 0; attempt < MAXIMUM_SEEDS; ++attempt )
+  {
+    _seed = hash_of( static_cast<std::uint64_t>( attempt ) + 1 );
+
+    // Group the UPCs by bucket (a counting sort), then place the largest buckets first, while there's the most room
+    std::vector<std::uint64_t> hashes( n );
+    std::vector<std::size_t>   bucketStarts( bucketCount + 1, 0 );
+    for( std::size_t i = 0; i < n; ++i )
+    {
+      hashes[i] = hash_of( entries[i].key ^ _seed );
+      ++bucketStarts[bucket_of( hashes[i], bucketCount ) + 1];
+    }
+    for( std::size_t b = 0; b < bucketCount; ++b ) bucketStarts[b + 1] += bucketStarts[b];
+
+    std::vector<std::size_t> members( n );
+    {
+      auto next = bucketStarts;
+      for( std::size_t i = 0; i < n; ++i ) members[next[bucket_of( hashes[i], bucketCount )]++] = i;
+    }
+
+    std::vector<std::size_t> order( bucketCount );
+    for( std::size_t b = 0; b < bucketCount; ++b ) order[b] = b;
+    std::stable_sort( order.begin(), order.end(), [&]( std::size_t lhs, std::size_t rhs ) { return bucketStarts[lhs + 1] - bucketStarts[lhs] > bucketStarts[rhs + 1] - bucketStarts[rhs]; } );
+
+    std::vector<bool>          taken( tableSize, false );
+    std::vector<std::size_t>   rawSlots( n );
+    std::vector<std::size_t>   trial;
+    bool                       placed = true;
+    _pilots.assign( bucketCount, 0 );
+
+    for( auto b : order )
+    {
+      auto const first = bucketStarts[b], last = bucketStarts[b + 1];
+      if( first == last ) break;                                              // empty buckets sort last, and need no pilot
+
+      std::uint32_t pilot = 0;
+      for( ; pilot < MAXIMUM_PILOT; ++pilot )
+      {
+        trial.clear();
+        bool fits = true;
+        for( auto m = first; fits && m < last; ++m )
+        {
+          auto const slot = raw_slot_of( hashes[members[m]], pilot, tableSize );
+          fits = !taken[slot] && std::find( trial.begin(), trial.end(), slot ) == trial.end();
+          trial.push_back( slot );
+        }
+        if( fits ) break;
+      }
+      if( pilot == MAXIMUM_PILOT ) { placed = false;  break; }
+
+      _pilots[b] = pilot;
+      for( auto m = first; m < last; ++m )
+      {
+        taken   [trial[m - first]] = true;
+        rawSlots[members[m]]       = trial[m - first];
+      }
+    }
+    if( !placed ) continue;
+
+    // Slots beyond n-1 are moved into the holes below n, one for one
+    _remap.assign( tableSize - n, 0 );
+    for( std::size_t slot = n, hole = 0; slot < tableSize; ++slot )
+    {
+      if( !taken[slot] ) continue;
+      while( taken[hole] ) ++hole;
+      _remap[slot - n] = static_cast<std::uint32_t>( hole++ );
+    }
+
+    _keys     .assign( n, 0 );
+    _positions.assign( n, 0 );
+    for( std::size_t i = 0; i < n; ++i )
+    {
+      auto const slot = rawSlots[i] < n ? rawSlots[i] : _remap[rawSlots[i] - n];
+      _keys     [slot] = entries[i].key;
+      _positions[slot] = entries[i].position;
+    }
+    return;
+  }
+
+  throw std::runtime_error( "Error - Runtime error:  no perfect hash found for these UPCs" );
+}
+
+
+
+
+// Adopt previously generated tables
+UpcPerfectHash::UpcPerfectHash( Tables const & tables, std::vector<GroceryItem> const & dataStore )
+  : _seed     ( tables.seed                                         ),
+    _pilots   ( tables.pilots   .begin(), tables.pilots   .end()    ),
+    _remap    ( tables.remap    .begin(), tables.remap    .end()    ),
+    _keys     ( tables.keys     .begin(), tables.keys     .end()    ),
+    _positions( tables.positions.begin(), tables.positions.end()    )
+{
+  auto const n = _keys.size();
+
+  // Every slot's UPC must hash to that very slot, and the slots together must hold exactly the data store's packed UPCs, each
+  // pointing to the first item with that UPC.
+  auto const entries = packed_entries( dataStore );
+  bool valid = _positions.size() == n  &&  ( n == 0 || !_pilots.empty() )  &&  entries.size() == n;
+  for( auto hole : _remap ) valid = valid && hole < n;
+  for( std::size_t slot = 0; valid && slot < n; ++slot ) valid = slot_of( _keys[slot] ) == slot;
+
+  if( valid )
+  {
+    std::vector<Entry> adopted( n );
+    for( std::size_t slot = 0; slot < n; ++slot ) adopted[slot] = { _keys[slot], _positions[slot] };
+    std::sort( adopted.begin(), adopted.end(), []( Entry const & lhs, Entry const & rhs ) { return lhs.key < rhs.key; } );
+    valid = std::equal( adopted.begin(), adopted.end(), entries.begin(), []( Entry const & lhs, Entry const & rhs ) { return lhs.key == rhs.key && lhs.position == rhs.position; } );
+  }
+
+  if( !valid ) throw std::invalid_argument( "Error - Invalid argument:  perfect hash tables don't match the grocery items" );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// find()
+std::size_t UpcPerfectHash::find( Upc upc ) const noexcept
+{
+  if( _keys.empty() ) return npos;
+
+  auto const slot = slot_of( upc.key() );
+  return _keys[slot] == upc.key() ? _positions[slot] : npos;
+}
+
+
+
+
+// size()
+std::size_t UpcPerfectHash::size() const noexcept
+{
+  return _keys.size();
+}
+
+
+
+
+// empty()
+bool UpcPerfectHash::empty() const noexcept
+{
+  return _keys.empty();
+}
+
+
+
+
+// size_bytes()
+std::size_t UpcPerfectHash::size_bytes() const noexcept
+{
+  return _pilots.size() * sizeof( std::uint32_t ) + _remap.size() * sizeof( std::uint32_t ) + _keys.size() * sizeof( std::uint64_t ) + _positions.size() * sizeof( std::uint32_t );
+}
+
+
+
+
+// tables()
+UpcPerfectHash::Tables UpcPerfectHash::tables() const noexcept
+{
+  return { _seed, _pilots, _remap, _keys, _positions };
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private Helpers
+*******************************************************************************/
+
+// slot_of()
+std::size_t UpcPerfectHash::slot_of( std::uint64_t key ) const noexcept
+{
+  auto const hash = hash_of( key ^ _seed );
+  auto const n    = _keys.size();
+  auto const slot = raw_slot_of( hash, _pilots[bucket_of( hash, _pilots.size() )], n + _remap.size() );
+  return slot < n ? slot : _remap[slot - n];
+}
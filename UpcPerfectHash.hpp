@@ -0,0 +1,64 @@
+#pragma once                                                                  // include guard
+
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint32_t, uint64_t
+#include <limits>                                                             // numeric_limits
+#include <span>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "Upc.hpp"
+
+
+
+
+// A minimal perfect hash over the UPCs of a catalog that no longer changes:  each of its n UPCs is mapped to its own slot 0..n-1,
+// so a lookup is exactly one probe and one key compare, with no collisions to resolve, and a UPC that isn't in the catalog is
+// rejected by that one compare.
+//
+// It is built by hash and displace (as in PTHash).  UPCs are hashed into buckets of about four, and each bucket is given the
+// smallest "pilot" that sends all of its UPCs to slots nobody else has taken yet, largest buckets first while the table is still
+// empty.  To keep that search short the slots are spread over a table 1% larger than n, and the few UPCs landing beyond slot n-1
+// are then moved into the holes left below it through a small remap table.  Building takes a fraction of a second per hundred
+// thousand UPCs; a lookup costs a hash, a pilot read, and the probe.
+//
+// Only packed UPCs (see class Upc) are hashed.  The tables can be written out as C++ and compiled into a program (see
+// UpcPerfectHashGenerator), which then adopts them instead of building them at startup.
+class UpcPerfectHash
+{
+  public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();  // returned by find() when the UPC is not in the catalog
+
+    // The tables that define a perfect hash, as views so generated tables can be constexpr arrays
+    struct Tables
+    {
+      std::uint64_t                   seed = 0;
+      std::span<std::uint32_t const>  pilots;                                 // one per bucket
+      std::span<std::uint32_t const>  remap;                                  // slot n+i lands in slot remap[i]
+      std::span<std::uint64_t const>  keys;                                   // packed UPC in each of the n slots
+      std::span<std::uint32_t const>  positions;                              // where the item with keys[i] lives in the data store
+    };
+
+    // Constructors
+    UpcPerfectHash() = default;                                               // an empty hash, finds nothing
+    explicit UpcPerfectHash( std::vector<GroceryItem> const & dataStore );   // hash every packed UPC in dataStore.  When UPCs repeat, the first one wins
+    UpcPerfectHash( Tables const & tables, std::vector<GroceryItem> const & dataStore );   // adopt previously generated tables (see tables()).  Throws
+                                                                                            // std::invalid_argument unless they hash exactly dataStore's packed UPCs,
+                                                                                            // each to the first item with that UPC
+
+    // Queries
+    std::size_t find      ( Upc upc ) const noexcept;                         // position of upc in the data store, npos if not found
+    std::size_t size      () const noexcept;                                  // number of UPCs hashed
+    bool        empty     () const noexcept;
+    std::size_t size_bytes() const noexcept;                                  // memory held by the tables
+    Tables      tables    () const noexcept;                                  // views of the tables, valid as long as this hash is
+
+  private:
+    std::size_t slot_of( std::uint64_t key ) const noexcept;                  // the one slot key can be in
+
+    std::uint64_t              _seed = 0;
+    std::vector<std::uint32_t> _pilots;
+    std::vector<std::uint32_t> _remap;
+    std::vector<std::uint64_t> _keys;
+    std::vector<std::uint32_t> _positions;
+};
@@ -0,0 +1,113 @@
+// Generates C++ defining a minimal perfect hash over every UPC in a grocery item database file, so a program can compile it in and
+// freeze the database it loads from that file without building the hash at startup.
+//
+// Usage:  UpcPerfectHashGenerator  database.dat  [header  [namespace]]
+//
+//   database.dat   a grocery item database in the quoted text format (Ex: Grocery_UPC_Database-Full.dat), or its snapshot
+//   header         where to write the generated header.  Defaults to "GroceryUpcPerfectHash.hpp".
+//   namespace      the namespace the tables are defined in.  Defaults to GroceryUpcPerfectHash.
+//
+// A program then freezes the database loaded from the same file with the generated tables:
+//
+//      #include "GroceryUpcPerfectHash.hpp"
+//      GroceryItemDatabase::instance().freeze( GroceryUpcPerfectHash::tables );
+//
+// The tables record where each item sits in the database, so regenerate them whenever the file changes.  freeze() checks them and
+// throws std::invalid_argument if they no longer match.
+//
+// Build this file as its own program, linked with GroceryItem.cpp, GroceryItemDatabase.cpp, and the files they depend on.
+
+#include <algorithm>                                                                        // max()
+#include <cstddef>                                                                          // size_t
+#include <cstdint>                                                                          // uint32_t, uint64_t
+#include <exception>
+#include <filesystem>                                                                       // exists(), path
+#include <fstream>                                                                          // ofstream
+#include <iostream>                                                                         // cout, cerr
+#include <span>
+#include <string>
+#include <thread>                                                                           // hardware_concurrency()
+
+#include "GroceryItemDatabase.hpp"
+#include "UpcPerfectHash.hpp"
+
+
+
+namespace  // anonymous
+{
+  // One constexpr std::array, eight values per line
+  template<typename T>
+  void write_array( std::ostream & out, std::string const & name, std::span<T const> values )
+  {
+    out << "  inline constexpr std::array<std::" << ( sizeof( T ) == 8 ? "uint64_t" : "uint32_t" ) << ", " << values.size() << "> " << name << " =\n  {{";
+    for( std::size_t i = 0; i < values.size(); ++i )
+    {
+      out << ( i == 0 ? "" : "," ) << ( i % 8 == 0 ? "\n    " : " " ) << values[i] << ( sizeof( T ) == 8 ? "ULL" : "U" );
+    }
+    out << "\n  }};\n\n";
+  }
+}    // namespace
+
+
+
+int main( int argc, char * argv[] )
+{
+  try
+  {
+    if( argc < 2 )
+    {
+      std::cerr << "Usage:  " << argv[0] << "  database.dat  [header  [namespace]]\n";
+      return 2;
+    }
+
+    std::string const input      = argv[1];
+    std::string const output     = argc >= 3 ? argv[2] : "GroceryUpcPerfectHash.hpp";
+    std::string const identifier = argc >= 4 ? argv[3] : "GroceryUpcPerfectHash";
+
+    if( !std::filesystem::exists( input ) )
+    {
+      std::cerr << "ERROR:  grocery item database \"" << input << "\" not found\n";
+      return 1;
+    }
+
+    GroceryItemDatabase database( input, std::max( 1U, std::thread::hardware_concurrency() ) );
+    database.freeze();
+    auto const tables = database.frozen_tables();
+
+    std::ofstream out( output );
+    if( !out )
+    {
+      std::cerr << "ERROR:  could not create \"" << output << "\"\n";
+      return 1;
+    }
+
+    out << "// Generated by UpcPerfectHashGenerator from \"" << input << "\" (" << tables.keys.size() << " UPCs).  Do not edit, regenerate it\n"
+        << "// whenever that file changes.  See GroceryItemDatabase::freeze().\n"
+        << "#pragma once\n\n"
+        << "#include <array>\n"
+        << "#include <cstdint>\n\n"
+        << "#include \"UpcPerfectHash.hpp\"\n\n\n\n\n"
+        << "namespace " << identifier << "\n{\n";
+    write_array( out, "pilots",    tables.pilots    );
+    write_array( out, "remap",     tables.remap     );
+    write_array( out, "keys",      tables.keys      );
+    write_array( out, "positions", tables.positions );
+    out << "  inline constexpr UpcPerfectHash::Tables tables = { " << tables.seed << "ULL, pilots, remap, keys, positions };\n"
+        << "}    // namespace " << identifier << '\n';
+
+    if( !out )
+    {
+      std::cerr << "ERROR:  could not write \"" << output << "\"\n";
+      return 1;
+    }
+
+    std::cout << "Wrote a perfect hash of " << tables.keys.size() << " UPCs from \"" << input << "\" to \"" << output << "\"\n";
+  }
+
+  catch( std::exception & ex )
+  {
+    std::cerr << "ERROR:  Unhandled exception:  " << ex.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,212 @@
+#include <cstdint>                                                                          // uint64_t
+#include <exception>
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <random>                                                                           // mt19937_64, uniform_int_distribution
+#include <stdexcept>                                                                        // invalid_argument
+#include <string>
+#include <utility>                                                                          // swap()
+#include <vector>
+
+#include "CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "Upc.hpp"
+#include "UpcFilter.hpp"
+#include "UpcIndex.hpp"
+#include "UpcPerfectHash.hpp"
+
+
+
+
+
+namespace  // anonymous
+{
+  class UpcRegressionTest
+  {
+    public:
+      UpcRegressionTest();
+
+    private:
+      void tests();
+      void filter();
+      void small_index();
+      void perfect_hash();
+
+      Regression::CheckResults affirm;
+  } run_upc_tests;
+
+
+
+
+  void UpcRegressionTest::tests()
+  {
+    {  // Canonical form survives packing, leading zeros included
+      for( auto digits : { "00014100072331", "051600080015", "5010724527375", "12844098150", "0", "00000000000000000" } )
+      {
+        affirm.is_equal( "UPC round trip                                    ", std::string( digits ), Upc( digits ).to_string() );
+      }
+    }
+
+    {  // Leading zeros and length are significant
+      affirm.is_true( "UPC equality - same digits                        ", Upc( "00014100072331" ) == Upc( "00014100072331" ) );
+      affirm.is_true( "UPC inequality - leading zero                     ", Upc(  "0014100072331" ) != Upc( "00014100072331" ) );
+      affirm.is_true( "UPC inequality - one digit                        ", Upc( "00014100072332" ) != Upc( "00014100072331" ) );
+      affirm.is_equal( "UPC length                                        ", 14u, Upc( "00014100072331" ).length() );
+      affirm.is_equal( "UPC value                                         ", std::uint64_t{ 14100072331 }, Upc( "00014100072331" ).value() );
+      affirm.is_true( "UPC key is never zero                             ", Upc( "0" ).key() != 0 );
+    }
+
+    {  // Digits are checked on parse
+      affirm.is_true( "UPC parse - empty                                 ", !Upc::parse( ""                   ) );
+      affirm.is_true( "UPC parse - not a digit                           ", !Upc::parse( "--------------"     ) );
+      affirm.is_true( "UPC parse - embedded letter                       ", !Upc::parse( "0001410007233X"     ) );
+      affirm.is_true( "UPC parse - too many digits                       ", !Upc::parse( "123456789012345678" ) );
+      affirm.is_true( "UPC parse - maximum digits                        ",  Upc::parse( "99999999999999999"  ).has_value() );
+
+      bool thrown = false;
+      try                                   { Upc upc( "grocery item's UPC code" ); }
+      catch( std::invalid_argument const & ) { thrown = true; }
+      affirm.is_true( "UPC construction - invalid digits throw           ", thrown );
+    }
+  }
+
+
+
+
+  void UpcRegressionTest::filter()
+  {
+    // Random 14 digit UPCs, the first half inserted and the second half (almost surely) not
+    constexpr std::size_t                        COUNT = 100'000;
+    std::mt19937_64                              random( 20'241'018 );
+    std::uniform_int_distribution<std::uint64_t> pick( 0, 99'999'999'999'999 );
+
+    std::vector<Upc> upcs;
+    for( std::size_t i = 0; i < 2 * COUNT; ++i )
+    {
+      auto digits = std::to_string( pick( random ) );
+      upcs.emplace_back( std::string( 14 - digits.size(), '0' ) + digits );
+    }
+
+    UpcFilter filter( COUNT );
+    for( std::size_t i = 0; i < COUNT; ++i ) filter.insert( upcs[i] );
+
+    bool        allFound       = true;
+    std::size_t falsePositives = 0;
+    for( std::size_t i = 0;     i < COUNT;     ++i ) allFound        = allFound && filter.might_contain( upcs[i] );
+    for( std::size_t i = COUNT; i < 2 * COUNT; ++i ) falsePositives += filter.might_contain( upcs[i] );
+
+    affirm.is_true ( "UPC filter - never rejects an inserted UPC        ", allFound );
+    affirm.is_true ( "UPC filter - false positive rate under 1%         ", falsePositives < COUNT / 100 );
+    affirm.is_true ( "UPC filter - an empty filter rejects nothing      ", UpcFilter().might_contain( upcs.front() ) );
+    affirm.is_true ( "UPC filter - a sized filter accepts nothing yet   ", !UpcFilter( COUNT ).might_contain( upcs.front() ) );
+    affirm.is_true ( "UPC filter - compact                              ", filter.size_bytes() <= COUNT * UpcFilter::BITS_PER_UPC / 8 * 2 );
+  }
+
+
+
+  void UpcRegressionTest::small_index()
+  {
+    // Catalogs small enough to be scanned, and the first few too large to be, through inserts, erases (tombstones), and relocations
+    bool allFound = true, noneFound = true, erasedGone = true, relocatedFound = true;
+    for( std::size_t size = 0; size <= 20; ++size )
+    {
+      std::vector<GroceryItem> dataStore;
+      for( std::size_t i = 0; i < size; ++i ) dataStore.emplace_back( "", "", std::to_string( 20'000'000'000'000 + i * 13 ) );
+      dataStore.emplace_back( "", "", "NOT-A-UPC" );
+
+      UpcIndex index( dataStore );
+      for( std::size_t i = 0; i < size; ++i ) allFound  = allFound  && index.find( Upc( dataStore[i].upcCode() ) ) == i;
+      for( std::size_t i = 0; i < size; ++i ) noneFound = noneFound && index.find( Upc( std::to_string( 20'000'000'000'001 + i * 13 ) ) ) == UpcIndex::npos;
+      noneFound = noneFound && index.find( Upc( "0" ) ) == UpcIndex::npos;
+
+      // Erase the first item, and move the last packed one into its place, as the database does
+      if( size < 2 ) continue;
+      auto const erased = Upc( dataStore.front().upcCode() );
+      index.erase   ( dataStore, 0        );
+      index.relocate( dataStore, size - 1, 0 );
+      std::swap( dataStore.front(), dataStore[size - 1] );
+
+      erasedGone     = erasedGone     && index.find( erased ) == UpcIndex::npos;
+      relocatedFound = relocatedFound && index.find( Upc( dataStore.front().upcCode() ) ) == 0;
+      for( std::size_t i = 1; i + 1 < size; ++i ) relocatedFound = relocatedFound && index.find( Upc( dataStore[i].upcCode() ) ) == i;
+    }
+
+    affirm.is_true( "UPC small index - finds every UPC                 ", allFound       );
+    affirm.is_true( "UPC small index - finds no others                 ", noneFound      );
+    affirm.is_true( "UPC small index - erased UPC is gone              ", erasedGone     );
+    affirm.is_true( "UPC small index - relocated UPCs are found        ", relocatedFound );
+    affirm.is_equal( "UPC small index - empty                           ", UpcIndex::npos, UpcIndex().find( Upc( "0" ) ) );
+  }
+
+
+
+
+  void UpcRegressionTest::perfect_hash()
+  {
+    // Sizes around the bucket size and the slack, so the remap table is empty, short, and long
+    bool allFound = true, noneFound = true, minimal = true;
+    for( std::size_t size : { 1, 2, 3, 4, 5, 99, 100, 101, 1'000, 50'000 } )
+    {
+      std::vector<GroceryItem> dataStore;
+      for( std::size_t i = 0; i < size; ++i ) dataStore.emplace_back( "", "", std::to_string( 10'000'000'000'000 + i * 7 ) );
+      dataStore.emplace_back( "", "", "NOT-A-UPC" );                                         // unpacked UPCs are skipped
+
+      UpcPerfectHash const hash( dataStore );
+      minimal = minimal && hash.size() == size;
+      for( std::size_t i = 0;    i < size;     ++i ) allFound  = allFound  && hash.find( Upc( dataStore[i].upcCode() ) ) == i;
+      for( std::size_t i = size; i < 2 * size; ++i ) noneFound = noneFound && hash.find( Upc( std::to_string( 10'000'000'000'000 + i * 7 ) ) ) == UpcPerfectHash::npos;
+    }
+    affirm.is_true( "UPC perfect hash - one slot per UPC               ", minimal   );
+    affirm.is_true( "UPC perfect hash - finds every UPC                ", allFound  );
+    affirm.is_true( "UPC perfect hash - finds no others                ", noneFound );
+    affirm.is_true( "UPC perfect hash - empty                          ", UpcPerfectHash().find( Upc( "0" ) ) == UpcPerfectHash::npos && UpcPerfectHash( std::vector<GroceryItem>{} ).empty() );
+
+    std::vector<GroceryItem> dataStore = { { "", "", "001" }, { "", "", "002" }, { "", "", "003" } };
+    UpcPerfectHash const     hash( dataStore );
+    affirm.is_equal( "UPC perfect hash - adopt its own tables           ", std::size_t{ 2 }, UpcPerfectHash( hash.tables(), dataStore ).find( Upc( "003" ) ) );
+
+    auto rejects = [&]( std::vector<GroceryItem> const & other, UpcPerfectHash::Tables const & tables )
+    {
+      try                                     { UpcPerfectHash( tables, other ); }
+      catch( std::invalid_argument const & )  { return true;                      }
+      return false;
+    };
+    auto tables = hash.tables();
+    affirm.is_true( "UPC perfect hash - reject tables for other UPCs   ", rejects( { { "", "", "001" }, { "", "", "002" }, { "", "", "004" } }, tables )
+                                                                        && rejects( { { "", "", "001" }, { "", "", "002" } }, tables )
+                                                                        && rejects( { { "", "", "003" }, { "", "", "002" }, { "", "", "001" } }, tables )
+                                                                        && rejects( { { "", "", "001" }, { "", "", "002" }, { "", "", "003" }, { "", "", "004" } }, tables ) );
+    tables.keys = tables.keys.first( 2 );
+    affirm.is_true( "UPC perfect hash - reject malformed tables        ", rejects( dataStore, tables ) );
+
+    std::vector<GroceryItem> const repeated = { { "", "", "001" }, { "", "", "002" }, { "", "", "001" } };
+    UpcPerfectHash const           first( repeated );
+    affirm.is_true( "UPC perfect hash - repeated UPC finds the first   ", first.size() == 2 && first.find( Upc( "001" ) ) == 0
+                                                                        && UpcPerfectHash( first.tables(), repeated ).find( Upc( "001" ) ) == 0 );
+  }
+
+
+
+
+  UpcRegressionTest::UpcRegressionTest()
+  {
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\n\n\nUPC Regression Test:\n";
+      tests();
+      filter();
+      small_index();
+      perfect_hash();
+
+      std::clog << "\n\nUPC Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class Upc\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
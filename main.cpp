@@ -1,6 +1,5 @@
 #include <algorithm>                                                                      // max()
 #include <array>                                                                          // array
-#include <cmath>                                                                          // abs()
 #include <cstddef>                                                                        // size_t
 #include <exception>                                                                      // exception
 #include <format>                                                                         // format_to()
@@ -8,15 +7,17 @@
 #include <iterator>                                                                       // ostreambuf_iterator
 #include <locale>                                                                         // locale, use_facet, moneypunct
 #include <map>                                                                            // map
-#include <queue>                                                                          // queue
-#include <stack>                                                                          // stack
 #include <stdexcept>                                                                      // invalid_argument, out_of_range
 #include <string>                                                                         // stod(). string
 #include <string_view>                                                                    // string_view
-#include <utility>                                                                        // move()
+#include <vector>                                                                         // vector
 
+#include "CartMoves.hpp"
 #include "GroceryItem.hpp"
 #include "GroceryItemDatabase.hpp"
+#include "GroceryItemPool.hpp"
+#include "Money.hpp"
+#include "Upc.hpp"
 
 
 
@@ -26,7 +27,9 @@ namespace
   // Call this function from within the carefully_move_grocery_items functions, just before kicking off the recursion and then just after each move.
 
   // trace()
-  void trace( std::stack<GroceryItem> const & sourceCart, std::stack<GroceryItem> const & destinationCart, std::stack<GroceryItem> const & spareCart, std::ostream & s = std::clog )
+  //
+  // The carts hold handles into the pool of picked grocery items, so the snapshots of them taken here copy integers, not items
+  void trace( GroceryItemPool const & items, GroceryCart const & sourceCart, GroceryCart const & destinationCart, GroceryCart const & spareCart, std::ostream & s = std::clog )
   {
     // Count and label the number of moves
     static std::size_t move_number = 0;
@@ -38,7 +41,7 @@ namespace
     // the same objects - just in different orders. When outputting the stack contents, keep the original order so we humans can
     // trace the movements easier.  A container (std::map) indexed by the object's identity (address) is created to map address to a
     // predictable index and then the index is used so the canonical order remains the same from one invocation to the next.
-    auto createMapping = [&]() -> std::map<std::stack<GroceryItem> const *, const unsigned>      // Let's accommodate mixing up the parameters
+    auto createMapping = [&]() -> std::map<GroceryCart const *, const unsigned>                  // Let's accommodate mixing up the parameters
     {
       if( destinationCart.size() == 0 && spareCart.size() == 0 )
       {
@@ -51,11 +54,11 @@ namespace
       throw std::invalid_argument( "Error - Invalid argument:  Order of passed parameters passed to function trace(...) is incorrect" );
 
     };
-    static std::map<std::stack<GroceryItem> const *, const unsigned> indexMapping = createMapping();
+    static std::map<GroceryCart const *, const unsigned> indexMapping = createMapping();
     struct LabeledCart
     {
-      std::string             label;
-      std::stack<GroceryItem> cart;
+      std::string label;
+      GroceryCart cart;
     };
     static std::array<LabeledCart, 3> groceryCarts = { LabeledCart{ "Broken Cart",  {} },
                                                        LabeledCart{ "Working Cart", {} },
@@ -91,7 +94,7 @@ namespace
       {
         if( currentCart.cart.size() == tallestStackSize )                                                   // if the current cart is this tall, print the top grocery item
         {
-          std::string_view name = currentCart.cart.top().productName();
+          std::string_view name = items[currentCart.cart.top()].productName();
 
           if( name.size() > 24 ) std::format_to( obuf_itr, "{}... ", name.substr( 0, 21 ) );                // replace last few characters of long names with "..."
           else                   std::format_to( obuf_itr, "{:<25}", name) ;                                // 24 characters plus a space to separate columns
@@ -111,53 +114,16 @@ namespace
 
 
 
-  // carefully_move_grocery_items() - recursive
-  /*********************************************************************************************************************************
-  ** A recursive algorithm to carefully move grocery items from a broken cart to a working cart is given as follows:
-  ** START
-  ** Procedure carefully_move_grocery_items (number_of_items_to_be_moved, broken_cart, working_cart, spare_cart)
-  **
-  **    IF number_of_items_to_be_moved == 1, THEN
-  **       move top item from broken_cart to working_cart
-  **       trace the move
-  **
-  **    ELSE
-  **       carefully_move_grocery_items (number_of_items_to_be_moved-1, broken_cart, spare_cart, working_cart)
-  **       move top item from broken_cart to working_cart
-  **       trace the move
-  **       carefully_move_grocery_items (number_of_items_to_be_moved-1, spare_cart, working_cart, broken_cart)
-  **
-  **    END IF
-  **
-  ** END Procedure
-  ** STOP
-  **
-  ** As a side note, the efficiency class of this algorithm is exponential.  That is, the Big-O is O(2^n).
-  *********************************************************************************************************************************/
-  void carefully_move_grocery_items( std::size_t quantity, std::stack<GroceryItem> & broken_cart, std::stack<GroceryItem> & working_cart, std::stack<GroceryItem> & spare_cart )
+  // carefully_move_grocery_items()
+  //
+  // Carefully move every grocery item from one cart to another, through a spare, tracing each move.  The classic recursive algorithm
+  // (see CartMoves.hpp) recurses once per item; this runs the very same moves, in the same order, in a loop.  The carts hold handles,
+  // so each move copies an integer.
+  void carefully_move_grocery_items( GroceryItemPool const & items, GroceryCart & from, GroceryCart & to )
   {
-    if (quantity == 1)
-    {
-      working_cart.push(broken_cart.top());
-      broken_cart.pop();
-      trace(broken_cart, working_cart, spare_cart);
-    }
-    else
-    {
-      carefully_move_grocery_items(quantity - 1, broken_cart, spare_cart, working_cart);
-      working_cart.push(broken_cart.top());
-      broken_cart.pop();
-      trace(broken_cart, working_cart, spare_cart);
-      carefully_move_grocery_items(quantity - 1, spare_cart, working_cart, broken_cart);
-    }
-  }
-
-  // carefully_move_grocery_items() - starter
-  void carefully_move_grocery_items( std::stack<GroceryItem> & from, std::stack<GroceryItem> & to )
-  {
-    std::stack<GroceryItem> spare;
-    trace(from, to, spare);
-    carefully_move_grocery_items(from.size(), from, to, spare);
+    GroceryCart spare;
+    trace(items, from, to, spare);
+    carefully_move_iteratively(from.size(), from, to, spare, [&](CartMove const &) { trace(items, from, to, spare); });
   }
 }    // namespace
 
@@ -169,8 +135,10 @@ int main( int argc, char * argv[] )
 {
   try
   {
-    // Snag an empty cart as I enter the grocery store
-    std::stack<GroceryItem> myCart;
+    // Snag an empty cart as I enter the grocery store.  The grocery items I pick are kept in a pool, and the carts and the checkout
+    // counter hold handles to them, so moving an item from one to another copies an integer rather than the item.
+    GroceryItemPool pickedItems;
+    GroceryCart     myCart;
 
     // Shop for a while placing grocery items into my grocery item cart
     //
@@ -186,19 +154,19 @@ int main( int argc, char * argv[] )
     //      00038000291210   rice krispies    Kellogg's
     //      00075457129000   milk             any                     <===  heaviest item, put this on the bottom
 
-    myCart.push(GroceryItem("eggs", "any", "00688267039317", 77.47));
-    myCart.push(GroceryItem("bread", "any", "00835841005255", 8.73));
-    myCart.push(GroceryItem("apple pie", "any", "09073649000493", 0.0));
-    myCart.push(GroceryItem("hotdogs", "Applegate Farms", "00025317533003", 15.99));
-    myCart.push(GroceryItem("rice krispies", "Kellogg's", "00038000291210", 40.37));
-    myCart.push(GroceryItem("milk", "any", "00075457129000", 30.28));
+    myCart.push(pickedItems.add(GroceryItem("eggs", "any", "00688267039317", 77.47)));
+    myCart.push(pickedItems.add(GroceryItem("bread", "any", "00835841005255", 8.73)));
+    myCart.push(pickedItems.add(GroceryItem("apple pie", "any", "09073649000493", 0.0)));
+    myCart.push(pickedItems.add(GroceryItem("hotdogs", "Applegate Farms", "00025317533003", 15.99)));
+    myCart.push(pickedItems.add(GroceryItem("rice krispies", "Kellogg's", "00038000291210", 40.37)));
+    myCart.push(pickedItems.add(GroceryItem("milk", "any", "00075457129000", 30.28)));
 
     // A wheel on my cart has just broken and I need to move grocery items to a new cart that works
-    std::stack<GroceryItem> workingCart;
-    carefully_move_grocery_items(myCart, workingCart);
+    GroceryCart workingCart;
+    carefully_move_grocery_items(pickedItems, myCart, workingCart);
 
     // Time to checkout and pay for all this stuff.  Find a checkout line and start placing grocery items on the counter's conveyor belt
-    std::queue<GroceryItem> checkoutCounter;
+    CheckoutLane checkoutCounter;
     while (!workingCart.empty())
     {
       checkoutCounter.push(workingCart.top());
@@ -206,36 +174,47 @@ int main( int argc, char * argv[] )
     }
 
     // Now add it all up and print a receipt
-    double amountDue = 0.0;
+    Money amountDue;                                                                        // in whole cents, so the total is exact
     GroceryItemDatabase & worldWideDatabase = GroceryItemDatabase::instance();              // Get a reference to the world wide database of grocery items. The database
                                                                                             // contains the full description and price of the grocery item.
 
-    while (!checkoutCounter.empty())
+    // Scan the whole cart at once so the database can overlap the lookups instead of waiting on each in turn.  A UPC that isn't all
+    // digits can't be packed, so it's looked up on its own.
+    std::vector<GroceryItemPool::Handle> scannedItems;
+    for (; !checkoutCounter.empty(); checkoutCounter.pop()) scannedItems.push_back(checkoutCounter.front());
+
+    std::vector<Upc> upcs;
+    upcs.reserve(scannedItems.size());
+    for (auto handle : scannedItems) if (auto upc = Upc::parse(pickedItems[handle].upcCode())) upcs.push_back(*upc);
+
+    auto matches = worldWideDatabase.find_many(upcs);
+    auto match   = matches.begin();
+
+    for (auto handle : scannedItems)
     {
-      const auto &item = checkoutCounter.front();
-      GroceryItem *dbItem = worldWideDatabase.find(item.upcCode());
+      const GroceryItem &item = pickedItems[handle];
+      GroceryItem *dbItem = Upc::parse(item.upcCode()) ? *match++ : worldWideDatabase.find(item.upcCode());
       if (dbItem)
       {
         std::cout << *dbItem << '\n';
-        amountDue += dbItem->price();
+        amountDue += dbItem->exactPrice();
       }
       else
       {
         std::cout << item.upcCode() << " (" << item.productName() << ") not found, so today is your lucky day - You get it free! Hooray!\n";
       }
-      checkoutCounter.pop();
     }
 
     // Now check the receipt - are you getting charged the correct amount?
     // You can either pass the expected total when you run the program by supplying a parameter, like this:
     //    program 35.89
     // or if no expected results is provided at the command line, then prompt for and obtain expected result from standard input
-    double expectedAmountDue = 0.0;
+    Money expectedAmountDue;
     if( argc >= 2 )
     {
       try
       {
-        expectedAmountDue = std::stod( argv[1] );
+        expectedAmountDue = Money( std::stod( argv[1] ) );
       }
       catch( std::invalid_argument & ) {}                                                   // ignore anticipated bad command line argument
       catch( std::range_error &      ) {}                                                   // ignore anticipated bad command line argument
@@ -248,9 +227,9 @@ int main( int argc, char * argv[] )
 
     auto locale          = std::locale( "en_US.UTF-8" );
     auto currency_symbol = std::use_facet<std::moneypunct<char>>( locale ).curr_symbol();
-    std::cout << std::format( locale, "{:->25}\nTotal  {}{:.2Lf}\n\n\n", "", currency_symbol, amountDue );
+    std::cout << std::format( locale, "{:->25}\nTotal  {}{:.2Lf}\n\n\n", "", currency_symbol, amountDue.dollars() );
 
-    if( std::abs(amountDue - expectedAmountDue) < 1E-4 ) std::clog << "PASS - Amount due matches expected\n";
+    if( amountDue == expectedAmountDue )                 std::clog << "PASS - Amount due matches expected\n";
     else                                                 std::clog << "FAIL - You're not paying the amount you should be paying\n";
   }
 